@@ -0,0 +1,141 @@
+//----------------------------------------------------------------------------------------------------
+// ChessAttackTables.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/Chess/ChessCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Attack and push tables for the pieces whose moves do not depend on occupancy, generated at compile
+/// time. Pawn entries are indexed by the pawn's owner: player 0 moves towards rank 8, player 1
+/// towards rank 1. Double pushes are only set for pawns on their starting rank.
+struct sLeaperAttackTables
+{
+    Bitboard m_pawnAttacks[NUM_PLAYERS][NUM_SQUARES]      = {};
+    Bitboard m_pawnPushes[NUM_PLAYERS][NUM_SQUARES]       = {};
+    Bitboard m_pawnDoublePushes[NUM_PLAYERS][NUM_SQUARES] = {};
+    Bitboard m_knightAttacks[NUM_SQUARES]                 = {};
+    Bitboard m_kingAttacks[NUM_SQUARES]                   = {};
+};
+
+//----------------------------------------------------------------------------------------------------
+Bitboard constexpr PROMOTION_RANK_BITBOARDS[NUM_PLAYERS] = {RANK_8_BITBOARD, RANK_1_BITBOARD};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Bit of the square offset from (file, rank), or 0 if the offset leaves the board.
+constexpr Bitboard GetOffsetSquareBit(int const file,
+                                      int const rank,
+                                      int const fileOffset,
+                                      int const rankOffset)
+{
+    int const targetFile = file + fileOffset;
+    int const targetRank = rank + rankOffset;
+
+    if (targetFile < 0 || targetFile > 7 || targetRank < 0 || targetRank > 7) return 0;
+
+    return GetSquareBit(GetSquare(targetFile, targetRank));
+}
+
+//----------------------------------------------------------------------------------------------------
+constexpr sLeaperAttackTables BuildLeaperAttackTables()
+{
+    int constexpr KNIGHT_OFFSETS[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+    int constexpr KING_OFFSETS[8][2]   = {{0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}, {-1, 0}, {-1, 1}};
+
+    sLeaperAttackTables tables;
+
+    for (int square = 0; square < NUM_SQUARES; ++square)
+    {
+        int const file = GetFile(square);
+        int const rank = GetRank(square);
+
+        tables.m_pawnAttacks[0][square] = GetOffsetSquareBit(file, rank, -1, 1) | GetOffsetSquareBit(file, rank, 1, 1);
+        tables.m_pawnAttacks[1][square] = GetOffsetSquareBit(file, rank, -1, -1) | GetOffsetSquareBit(file, rank, 1, -1);
+        tables.m_pawnPushes[0][square]  = GetOffsetSquareBit(file, rank, 0, 1);
+        tables.m_pawnPushes[1][square]  = GetOffsetSquareBit(file, rank, 0, -1);
+
+        if (rank == 1) tables.m_pawnDoublePushes[0][square] = GetOffsetSquareBit(file, rank, 0, 2);
+        if (rank == 6) tables.m_pawnDoublePushes[1][square] = GetOffsetSquareBit(file, rank, 0, -2);
+
+        for (int offsetIndex = 0; offsetIndex < 8; ++offsetIndex)
+        {
+            tables.m_knightAttacks[square] |= GetOffsetSquareBit(file, rank, KNIGHT_OFFSETS[offsetIndex][0], KNIGHT_OFFSETS[offsetIndex][1]);
+            tables.m_kingAttacks[square] |= GetOffsetSquareBit(file, rank, KING_OFFSETS[offsetIndex][0], KING_OFFSETS[offsetIndex][1]);
+        }
+    }
+
+    return tables;
+}
+
+//----------------------------------------------------------------------------------------------------
+inline constexpr sLeaperAttackTables LEAPER_ATTACK_TABLES = BuildLeaperAttackTables();
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Checks the tables against the move-shape rules Match's Validate* functions applied before they
+/// switched to the tables: knights move (1, 2) or (2, 1), kings at most one square each way, pawns
+/// one square forward, two from their starting rank, or one diagonally forward to capture. Every
+/// shape lies within two squares of the origin, so only that window is scanned, and the whole table
+/// entry is compared so stray bits outside the window fail too. Runs per from-rank so each constant
+/// evaluation stays well inside compiler step limits.
+constexpr bool DoLeaperTablesMatchMoveShapes(int const fromRank)
+{
+    for (int fromFile = 0; fromFile < 8; ++fromFile)
+    {
+        int const fromSquare                    = GetSquare(fromFile, fromRank);
+        Bitboard  knightMoves                   = 0;
+        Bitboard  kingMoves                     = 0;
+        Bitboard  pawnPushes[NUM_PLAYERS]       = {};
+        Bitboard  pawnDoublePushes[NUM_PLAYERS] = {};
+        Bitboard  pawnCaptures[NUM_PLAYERS]     = {};
+
+        for (int deltaY = -2; deltaY <= 2; ++deltaY)
+        {
+            for (int deltaX = -2; deltaX <= 2; ++deltaX)
+            {
+                Bitboard const toBit     = GetOffsetSquareBit(fromFile, fromRank, deltaX, deltaY);
+                int const      absDeltaX = deltaX < 0 ? -deltaX : deltaX;
+                int const      absDeltaY = deltaY < 0 ? -deltaY : deltaY;
+
+                if ((absDeltaX == 2 && absDeltaY == 1) || (absDeltaX == 1 && absDeltaY == 2)) knightMoves |= toBit;
+                if (absDeltaX <= 1 && absDeltaY <= 1 && (absDeltaX | absDeltaY) != 0) kingMoves |= toBit;
+
+                for (int playerId = 0; playerId < NUM_PLAYERS; ++playerId)
+                {
+                    int const direction    = playerId == 0 ? 1 : -1;
+                    int const startingRank = playerId == 0 ? 1 : 6;
+
+                    if (deltaX == 0 && deltaY == direction) pawnPushes[playerId] |= toBit;
+                    if (deltaX == 0 && deltaY == 2 * direction && fromRank == startingRank) pawnDoublePushes[playerId] |= toBit;
+                    if (absDeltaX == 1 && deltaY == direction) pawnCaptures[playerId] |= toBit;
+                }
+            }
+        }
+
+        if (LEAPER_ATTACK_TABLES.m_knightAttacks[fromSquare] != knightMoves) return false;
+        if (LEAPER_ATTACK_TABLES.m_kingAttacks[fromSquare] != kingMoves) return false;
+
+        for (int playerId = 0; playerId < NUM_PLAYERS; ++playerId)
+        {
+            if (LEAPER_ATTACK_TABLES.m_pawnPushes[playerId][fromSquare] != pawnPushes[playerId]) return false;
+            if (LEAPER_ATTACK_TABLES.m_pawnDoublePushes[playerId][fromSquare] != pawnDoublePushes[playerId]) return false;
+            if (LEAPER_ATTACK_TABLES.m_pawnAttacks[playerId][fromSquare] != pawnCaptures[playerId]) return false;
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+static_assert(DoLeaperTablesMatchMoveShapes(0), "Leaper tables disagree with the move-shape rules on rank 1");
+static_assert(DoLeaperTablesMatchMoveShapes(1), "Leaper tables disagree with the move-shape rules on rank 2");
+static_assert(DoLeaperTablesMatchMoveShapes(2), "Leaper tables disagree with the move-shape rules on rank 3");
+static_assert(DoLeaperTablesMatchMoveShapes(3), "Leaper tables disagree with the move-shape rules on rank 4");
+static_assert(DoLeaperTablesMatchMoveShapes(4), "Leaper tables disagree with the move-shape rules on rank 5");
+static_assert(DoLeaperTablesMatchMoveShapes(5), "Leaper tables disagree with the move-shape rules on rank 6");
+static_assert(DoLeaperTablesMatchMoveShapes(6), "Leaper tables disagree with the move-shape rules on rank 7");
+static_assert(DoLeaperTablesMatchMoveShapes(7), "Leaper tables disagree with the move-shape rules on rank 8");
+static_assert(LEAPER_ATTACK_TABLES.m_knightAttacks[0] == (GetSquareBit(10) | GetSquareBit(17)), "Knight on a1 attacks c2 and b3");
+static_assert(LEAPER_ATTACK_TABLES.m_pawnDoublePushes[0][12] == GetSquareBit(28), "White pawn on e2 double-pushes to e4");
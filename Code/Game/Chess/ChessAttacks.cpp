@@ -0,0 +1,137 @@
+//----------------------------------------------------------------------------------------------------
+// ChessAttacks.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessAttacks.hpp"
+
+#include "Game/Chess/ChessPosition.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    struct sLineTables
+    {
+        Bitboard m_squaresBetween[NUM_SQUARES][NUM_SQUARES] = {};
+    };
+
+    //------------------------------------------------------------------------------------------------
+    sLineTables BuildLineTables()
+    {
+        int constexpr DIRECTIONS[8][2] = {{0, 1}, {1, 1}, {1, 0}, {1, -1}, {0, -1}, {-1, -1}, {-1, 0}, {-1, 1}};
+
+        sLineTables tables;
+
+        for (int square = 0; square < NUM_SQUARES; ++square)
+        {
+            for (int directionIndex = 0; directionIndex < 8; ++directionIndex)
+            {
+                Bitboard between = 0;
+                int      file    = GetFile(square) + DIRECTIONS[directionIndex][0];
+                int      rank    = GetRank(square) + DIRECTIONS[directionIndex][1];
+
+                while (file >= 0 && file <= 7 && rank >= 0 && rank <= 7)
+                {
+                    int const targetSquare = GetSquare(file, rank);
+
+                    tables.m_squaresBetween[square][targetSquare] = between;
+                    between |= GetSquareBit(targetSquare);
+
+                    file += DIRECTIONS[directionIndex][0];
+                    rank += DIRECTIONS[directionIndex][1];
+                }
+            }
+        }
+
+        return tables;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sLineTables const& GetLineTables()
+    {
+        static sLineTables const s_lineTables = BuildLineTables();
+        return s_lineTables;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+Bitboard GetQueenAttacks(int const      square,
+                         Bitboard const occupancy)
+{
+    return GetBishopAttacks(square, occupancy) | GetRookAttacks(square, occupancy);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return Squares strictly between the two squares if they share a rank, file or diagonal, else 0.
+Bitboard GetSquaresBetween(int const fromSquare,
+                           int const toSquare)
+{
+    return GetLineTables().m_squaresBetween[fromSquare][toSquare];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Looks outward from the square with each piece's attack pattern; a pawn of the defender's
+/// colour on the square attacks exactly the squares an attacking pawn could capture from.
+bool IsSquareAttacked(ChessPosition const& position,
+                      int const            square,
+                      int const            attackerId)
+{
+    Bitboard const occupancy      = position.GetOccupancy();
+    Bitboard const queens         = position.GetPieces(attackerId, ePieceType::QUEEN);
+    Bitboard const rooksAndQueens = position.GetPieces(attackerId, ePieceType::ROOK) | queens;
+    Bitboard const bishopsQueens  = position.GetPieces(attackerId, ePieceType::BISHOP) | queens;
+
+    if (GetPawnAttacks(square, GetOpponentId(attackerId)) & position.GetPieces(attackerId, ePieceType::PAWN)) return true;
+    if (GetKnightAttacks(square) & position.GetPieces(attackerId, ePieceType::KNIGHT)) return true;
+    if (GetKingAttacks(square) & position.GetPieces(attackerId, ePieceType::KING)) return true;
+    if (bishopsQueens != 0 && (GetBishopAttacks(square, occupancy) & bishopsQueens)) return true;
+    if (rooksAndQueens != 0 && (GetRookAttacks(square, occupancy) & rooksAndQueens)) return true;
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Builds the set of squares the player attacks. Slider rays pass through the defending king,
+/// so a square behind the king on the line of a checking slider also counts as attacked; this lets
+/// "can the king step here" be answered by the map alone.
+Bitboard ComputeAttackedSquares(ChessPosition const& position,
+                                int const            attackerId)
+{
+    int const      defenderId = GetOpponentId(attackerId);
+    Bitboard const occupancy  = position.GetOccupancy() & ~position.GetPieces(defenderId, ePieceType::KING);
+    Bitboard const pawns      = position.GetPieces(attackerId, ePieceType::PAWN);
+    Bitboard const queens     = position.GetPieces(attackerId, ePieceType::QUEEN);
+
+    // Pawns attack as a set: shift diagonally forward, dropping the captures that wrap around a file edge
+    Bitboard attacks = attackerId == 0
+                           ? ((pawns & ~FILE_A_BITBOARD) << 7) | ((pawns & ~FILE_H_BITBOARD) << 9)
+                           : ((pawns & ~FILE_A_BITBOARD) >> 9) | ((pawns & ~FILE_H_BITBOARD) >> 7);
+
+    Bitboard knights = position.GetPieces(attackerId, ePieceType::KNIGHT);
+
+    while (knights != 0)
+    {
+        attacks |= GetKnightAttacks(PopLowestSquare(knights));
+    }
+
+    Bitboard bishopsAndQueens = position.GetPieces(attackerId, ePieceType::BISHOP) | queens;
+
+    while (bishopsAndQueens != 0)
+    {
+        attacks |= GetBishopAttacks(PopLowestSquare(bishopsAndQueens), occupancy);
+    }
+
+    Bitboard rooksAndQueens = position.GetPieces(attackerId, ePieceType::ROOK) | queens;
+
+    while (rooksAndQueens != 0)
+    {
+        attacks |= GetRookAttacks(PopLowestSquare(rooksAndQueens), occupancy);
+    }
+
+    int const kingSquare = position.GetKingSquare(attackerId);
+
+    if (kingSquare != INVALID_SQUARE) attacks |= GetKingAttacks(kingSquare);
+
+    return attacks;
+}
@@ -0,0 +1,34 @@
+//----------------------------------------------------------------------------------------------------
+// ChessAttacks.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/Chess/ChessAttackTables.hpp"
+#include "Game/Chess/ChessCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class ChessPosition;
+
+//----------------------------------------------------------------------------------------------------
+// Squares attacked by a piece of the given type standing on the square. Slider attacks stop at, and
+// include, the first occupied square in each direction; ChessSliderAttacks picks how they are computed.
+inline Bitboard GetPawnAttacks(int const square, int const playerId) { return LEAPER_ATTACK_TABLES.m_pawnAttacks[playerId][square]; }
+inline Bitboard GetKnightAttacks(int const square) { return LEAPER_ATTACK_TABLES.m_knightAttacks[square]; }
+inline Bitboard GetKingAttacks(int const square) { return LEAPER_ATTACK_TABLES.m_kingAttacks[square]; }
+Bitboard GetBishopAttacks(int square, Bitboard occupancy);
+Bitboard GetRookAttacks(int square, Bitboard occupancy);
+Bitboard GetQueenAttacks(int square, Bitboard occupancy);
+
+//----------------------------------------------------------------------------------------------------
+// Squares a pawn pushes to when they are empty. Double pushes exist only from the starting rank.
+inline Bitboard GetPawnPushes(int const square, int const playerId) { return LEAPER_ATTACK_TABLES.m_pawnPushes[playerId][square]; }
+inline Bitboard GetPawnDoublePushes(int const square, int const playerId) { return LEAPER_ATTACK_TABLES.m_pawnDoublePushes[playerId][square]; }
+
+//----------------------------------------------------------------------------------------------------
+// Squares strictly between two squares on a shared rank, file or diagonal; 0 if they are not aligned.
+Bitboard GetSquaresBetween(int fromSquare, int toSquare);
+
+//----------------------------------------------------------------------------------------------------
+bool     IsSquareAttacked(ChessPosition const& position, int square, int attackerId);
+Bitboard ComputeAttackedSquares(ChessPosition const& position, int attackerId);
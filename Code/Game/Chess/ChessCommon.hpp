@@ -0,0 +1,114 @@
+//----------------------------------------------------------------------------------------------------
+// ChessCommon.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------
+// One bit per square. Bit 0 is a1, bit 7 is h1, bit 56 is a8, bit 63 is h8.
+typedef uint64_t Bitboard;
+
+//----------------------------------------------------------------------------------------------------
+enum class ePieceType : int8_t
+{
+    NONE = -1,
+    PAWN,
+    BISHOP,
+    KNIGHT,
+    ROOK,
+    QUEEN,
+    KING
+};
+
+//----------------------------------------------------------------------------------------------------
+int constexpr NUM_PIECE_TYPES = 6;
+int constexpr NUM_PLAYERS     = 2;
+int constexpr NUM_SQUARES     = 64;
+int constexpr INVALID_SQUARE  = -1;
+
+//----------------------------------------------------------------------------------------------------
+// Castling rights bitmask
+uint8_t constexpr CASTLE_NONE            = 0;
+uint8_t constexpr CASTLE_WHITE_KINGSIDE  = 1 << 0;
+uint8_t constexpr CASTLE_WHITE_QUEENSIDE = 1 << 1;
+uint8_t constexpr CASTLE_BLACK_KINGSIDE  = 1 << 2;
+uint8_t constexpr CASTLE_BLACK_QUEENSIDE = 1 << 3;
+uint8_t constexpr CASTLE_ALL             = 0x0F;
+
+//----------------------------------------------------------------------------------------------------
+Bitboard constexpr FILE_A_BITBOARD = 0x0101010101010101ULL;
+Bitboard constexpr FILE_H_BITBOARD = FILE_A_BITBOARD << 7;
+Bitboard constexpr RANK_1_BITBOARD = 0x00000000000000FFULL;
+Bitboard constexpr RANK_8_BITBOARD = RANK_1_BITBOARD << 56;
+
+//----------------------------------------------------------------------------------------------------
+// Square helpers. Files and ranks are 0-based here (a1 = file 0, rank 0), unlike the 1-based
+// IntVec2 coords used by Board.
+constexpr int GetSquare(int const file, int const rank) { return rank * 8 + file; }
+constexpr int GetFile(int const square) { return square & 7; }
+constexpr int GetRank(int const square) { return square >> 3; }
+constexpr Bitboard GetSquareBit(int const square) { return 1ULL << square; }
+constexpr int GetOpponentId(int const playerId) { return playerId ^ 1; }
+
+//----------------------------------------------------------------------------------------------------
+/// @brief FEN letter of a piece, uppercase for player 0 and lowercase for player 1.
+/// @return '\0' for ePieceType::NONE.
+constexpr char GetPieceNotation(ePieceType const pieceType, int const playerId)
+{
+    if (pieceType == ePieceType::NONE) return '\0';
+
+    char const notation = "PBNRQK"[static_cast<int>(pieceType)];
+
+    return playerId == 1 ? static_cast<char>(notation - 'A' + 'a') : notation;
+}
+
+//----------------------------------------------------------------------------------------------------
+inline int PopCount(Bitboard const bitboard)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    return static_cast<int>(__popcnt64(bitboard));
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_popcountll(bitboard);
+#else
+    int      count     = 0;
+    Bitboard remaining = bitboard;
+    while (remaining != 0)
+    {
+        remaining &= remaining - 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Returns the index of the least significant set bit. The bitboard must not be empty.
+inline int GetLowestSquare(Bitboard const bitboard)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long index = 0;
+    _BitScanForward64(&index, bitboard);
+    return static_cast<int>(index);
+#elif defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(bitboard);
+#else
+    int square = 0;
+    while ((bitboard & GetSquareBit(square)) == 0) ++square;
+    return square;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Returns the least significant set bit and clears it from the bitboard.
+inline int PopLowestSquare(Bitboard& bitboard)
+{
+    int const square = GetLowestSquare(bitboard);
+    bitboard &= bitboard - 1;
+    return square;
+}
@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------------------------------
+// ChessEvaluation.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessEvaluation.hpp"
+
+#include "Game/Chess/ChessPosition.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    // Piece-square bonuses from white's side, laid out as the board is drawn: the first row is rank 8,
+    // so white's square s reads entry s ^ 56 and black's square s reads entry s.
+    int constexpr PAWN_TABLE[NUM_SQUARES] =
+    {
+          0,   0,   0,   0,   0,   0,   0,   0,
+         50,  50,  50,  50,  50,  50,  50,  50,
+         10,  10,  20,  30,  30,  20,  10,  10,
+          5,   5,  10,  25,  25,  10,   5,   5,
+          0,   0,   0,  20,  20,   0,   0,   0,
+          5,  -5, -10,   0,   0, -10,  -5,   5,
+          5,  10,  10, -20, -20,  10,  10,   5,
+          0,   0,   0,   0,   0,   0,   0,   0
+    };
+
+    int constexpr KNIGHT_TABLE[NUM_SQUARES] =
+    {
+        -50, -40, -30, -30, -30, -30, -40, -50,
+        -40, -20,   0,   0,   0,   0, -20, -40,
+        -30,   0,  10,  15,  15,  10,   0, -30,
+        -30,   5,  15,  20,  20,  15,   5, -30,
+        -30,   0,  15,  20,  20,  15,   0, -30,
+        -30,   5,  10,  15,  15,  10,   5, -30,
+        -40, -20,   0,   5,   5,   0, -20, -40,
+        -50, -40, -30, -30, -30, -30, -40, -50
+    };
+
+    int constexpr BISHOP_TABLE[NUM_SQUARES] =
+    {
+        -20, -10, -10, -10, -10, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,  10,  10,   5,   0, -10,
+        -10,   5,   5,  10,  10,   5,   5, -10,
+        -10,   0,  10,  10,  10,  10,   0, -10,
+        -10,  10,  10,  10,  10,  10,  10, -10,
+        -10,   5,   0,   0,   0,   0,   5, -10,
+        -20, -10, -10, -10, -10, -10, -10, -20
+    };
+
+    int constexpr ROOK_TABLE[NUM_SQUARES] =
+    {
+          0,   0,   0,   0,   0,   0,   0,   0,
+          5,  10,  10,  10,  10,  10,  10,   5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+         -5,   0,   0,   0,   0,   0,   0,  -5,
+          0,   0,   0,   5,   5,   0,   0,   0
+    };
+
+    int constexpr QUEEN_TABLE[NUM_SQUARES] =
+    {
+        -20, -10, -10,  -5,  -5, -10, -10, -20,
+        -10,   0,   0,   0,   0,   0,   0, -10,
+        -10,   0,   5,   5,   5,   5,   0, -10,
+         -5,   0,   5,   5,   5,   5,   0,  -5,
+          0,   0,   5,   5,   5,   5,   0,  -5,
+        -10,   5,   5,   5,   5,   5,   0, -10,
+        -10,   0,   5,   0,   0,   0,   0, -10,
+        -20, -10, -10,  -5,  -5, -10, -10, -20
+    };
+
+    int constexpr KING_MIDDLEGAME_TABLE[NUM_SQUARES] =
+    {
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -30, -40, -40, -50, -50, -40, -40, -30,
+        -20, -30, -30, -40, -40, -30, -30, -20,
+        -10, -20, -20, -20, -20, -20, -20, -10,
+         20,  20,   0,   0,   0,   0,  20,  20,
+         20,  30,  10,   0,   0,  10,  30,  20
+    };
+
+    int constexpr KING_ENDGAME_TABLE[NUM_SQUARES] =
+    {
+        -50, -40, -30, -20, -20, -30, -40, -50,
+        -30, -20, -10,   0,   0, -10, -20, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  30,  40,  40,  30, -10, -30,
+        -30, -10,  20,  30,  30,  20, -10, -30,
+        -30, -30,   0,   0,   0,   0, -30, -30,
+        -50, -30, -30, -30, -30, -30, -30, -50
+    };
+
+    // Indexed by ePieceType; the king is scored separately because its table depends on the phase
+    int const* const PIECE_SQUARE_TABLES[NUM_PIECE_TYPES - 1] = {PAWN_TABLE, BISHOP_TABLE, KNIGHT_TABLE, ROOK_TABLE, QUEEN_TABLE};
+
+    // Game phase weight per piece type; the starting position sums to MAX_GAME_PHASE
+    int constexpr GAME_PHASE_WEIGHTS[NUM_PIECE_TYPES] = {0, 1, 1, 2, 4, 0};
+    int constexpr MAX_GAME_PHASE                      = 24;
+
+    //------------------------------------------------------------------------------------------------
+    constexpr int GetTableIndex(int const square, int const playerId) { return playerId == 0 ? square ^ 56 : square; }
+}
+
+//----------------------------------------------------------------------------------------------------
+int EvaluatePosition(ChessPosition const& position)
+{
+    int score[NUM_PLAYERS]          = {};
+    int kingMiddlegame[NUM_PLAYERS] = {};
+    int kingEndgame[NUM_PLAYERS]    = {};
+    int gamePhase                   = 0;
+
+    for (int playerId = 0; playerId < NUM_PLAYERS; ++playerId)
+    {
+        for (int pieceTypeIndex = 0; pieceTypeIndex < NUM_PIECE_TYPES - 1; ++pieceTypeIndex)
+        {
+            Bitboard pieces = position.GetPieces(playerId, static_cast<ePieceType>(pieceTypeIndex));
+
+            gamePhase += PopCount(pieces) * GAME_PHASE_WEIGHTS[pieceTypeIndex];
+
+            while (pieces != 0)
+            {
+                int const square = PopLowestSquare(pieces);
+                score[playerId] += PIECE_VALUES[pieceTypeIndex] + PIECE_SQUARE_TABLES[pieceTypeIndex][GetTableIndex(square, playerId)];
+            }
+        }
+
+        int const kingSquare = position.GetKingSquare(playerId);
+
+        if (kingSquare == INVALID_SQUARE) continue;
+
+        kingMiddlegame[playerId] = KING_MIDDLEGAME_TABLE[GetTableIndex(kingSquare, playerId)];
+        kingEndgame[playerId]    = KING_ENDGAME_TABLE[GetTableIndex(kingSquare, playerId)];
+    }
+
+    // Early promotions can push the phase past the starting total
+    if (gamePhase > MAX_GAME_PHASE) gamePhase = MAX_GAME_PHASE;
+
+    for (int playerId = 0; playerId < NUM_PLAYERS; ++playerId)
+    {
+        score[playerId] += (kingMiddlegame[playerId] * gamePhase + kingEndgame[playerId] * (MAX_GAME_PHASE - gamePhase)) / MAX_GAME_PHASE;
+    }
+
+    int const sideToMove = position.GetSideToMove();
+
+    return score[sideToMove] - score[GetOpponentId(sideToMove)];
+}
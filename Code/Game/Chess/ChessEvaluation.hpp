@@ -0,0 +1,22 @@
+//----------------------------------------------------------------------------------------------------
+// ChessEvaluation.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/Chess/ChessCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class ChessPosition;
+
+//----------------------------------------------------------------------------------------------------
+// Material in centipawns, indexed by ePieceType. The king is never traded, so it is worth nothing.
+int constexpr PIECE_VALUES[NUM_PIECE_TYPES] = {100, 330, 320, 500, 900, 0};
+
+constexpr int GetPieceValue(ePieceType const pieceType) { return pieceType == ePieceType::NONE ? 0 : PIECE_VALUES[static_cast<int>(pieceType)]; }
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Static score of the position in centipawns from the side to move's point of view: material
+/// plus piece-square tables, with the king table blended from middlegame to endgame as the non-pawn
+/// material comes off. Does not look for mate or stalemate; that is the search's job.
+int EvaluatePosition(ChessPosition const& position);
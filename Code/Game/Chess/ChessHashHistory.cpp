@@ -0,0 +1,47 @@
+//----------------------------------------------------------------------------------------------------
+// ChessHashHistory.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessHashHistory.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+void ChessHashHistory::Push(uint64_t const hash)
+{
+    m_hashes[m_size & (HASH_HISTORY_SIZE - 1)] = hash;
+    ++m_size;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessHashHistory::Pop()
+{
+    if (m_size > 0) --m_size;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessHashHistory::Clear()
+{
+    m_size = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return How many earlier positions within the last halfmoveClock plies have the same key as the
+/// newest one. Only keys still held by the ring are compared.
+int ChessHashHistory::CountRepetitions(int const halfmoveClock) const
+{
+    if (m_size == 0) return 0;
+
+    int const      newestIndex   = m_size - 1;
+    int const      searchPlies   = std::min(halfmoveClock, std::min(newestIndex, HASH_HISTORY_SIZE - 1));
+    uint64_t const hash          = m_hashes[newestIndex & (HASH_HISTORY_SIZE - 1)];
+    int            repeatedCount = 0;
+
+    for (int pliesBack = 2; pliesBack <= searchPlies; pliesBack += 2)
+    {
+        if (m_hashes[(newestIndex - pliesBack) & (HASH_HISTORY_SIZE - 1)] == hash) ++repeatedCount;
+    }
+
+    return repeatedCount;
+}
@@ -0,0 +1,35 @@
+//----------------------------------------------------------------------------------------------------
+// ChessHashHistory.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+int constexpr HASH_HISTORY_SIZE = 256;  // Power of two; longer than any reversible span the 50-move rule allows
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Ring of the Zobrist keys of the positions reached so far, newest last, used for repetition
+/// detection. A position can only repeat within the plies since the last capture or pawn move (the
+/// halfmove clock) and only with the same side to move, so lookups walk back two plies at a time
+/// over that span alone. Push/Pop pair with MakeMove/UnmakeMove, so search can share the structure.
+class ChessHashHistory
+{
+public:
+    void Push(uint64_t hash);
+    void Pop();
+    void Clear();
+
+    int  CountRepetitions(int halfmoveClock) const;
+    bool IsRepetition(int halfmoveClock) const { return CountRepetitions(halfmoveClock) > 0; }
+    bool IsThreefoldRepetition(int halfmoveClock) const { return CountRepetitions(halfmoveClock) >= 2; }
+
+    int      GetSize() const { return m_size; }
+    uint64_t GetTop() const { return m_hashes[(m_size - 1) & (HASH_HISTORY_SIZE - 1)]; }
+
+private:
+    uint64_t m_hashes[HASH_HISTORY_SIZE] = {};
+    int      m_size                      = 0;    // Keys pushed in total; the newest is at (m_size - 1) mod HASH_HISTORY_SIZE
+};
@@ -0,0 +1,189 @@
+//----------------------------------------------------------------------------------------------------
+// ChessMove.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessMove.hpp"
+
+#include "Game/Chess/ChessPosition.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    // Promoted piece per low two bits of a promotion code
+    ePieceType constexpr PACKED_PROMOTION_TYPES[4] = {ePieceType::KNIGHT, ePieceType::BISHOP, ePieceType::ROOK, ePieceType::QUEEN};
+}
+
+//----------------------------------------------------------------------------------------------------
+bool sChessMove::operator==(sChessMove const& compare) const
+{
+    return m_fromSquare == compare.m_fromSquare &&
+        m_toSquare == compare.m_toSquare &&
+        m_promotionType == compare.m_promotionType;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool sChessMove::operator!=(sChessMove const& compare) const
+{
+    return !(*this == compare);
+}
+
+//----------------------------------------------------------------------------------------------------
+PackedMove PackMove(sChessMove const& move)
+{
+    uint8_t moveCode = move.IsCapture() ? PACKED_CAPTURE : PACKED_QUIET;
+
+    switch (move.m_flag)
+    {
+    case eChessMoveFlag::DOUBLE_PAWN_PUSH: moveCode = PACKED_DOUBLE_PAWN_PUSH; break;
+    case eChessMoveFlag::CASTLE_KINGSIDE:  moveCode = PACKED_CASTLE_KINGSIDE; break;
+    case eChessMoveFlag::CASTLE_QUEENSIDE: moveCode = PACKED_CASTLE_QUEENSIDE; break;
+    case eChessMoveFlag::EN_PASSANT:       moveCode = PACKED_EN_PASSANT; break;
+    default: break;
+    }
+
+    switch (move.m_promotionType)
+    {
+    case ePieceType::KNIGHT: moveCode |= PACKED_PROMOTION | 0; break;
+    case ePieceType::BISHOP: moveCode |= PACKED_PROMOTION | 1; break;
+    case ePieceType::ROOK:   moveCode |= PACKED_PROMOTION | 2; break;
+    case ePieceType::QUEEN:  moveCode |= PACKED_PROMOTION | 3; break;
+    default: break;
+    }
+
+    return static_cast<PackedMove>(move.m_fromSquare | (move.m_toSquare << 6) | (moveCode << 12));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Expands a packed move for the position it is about to be played in, which supplies the
+/// moving and captured piece types.
+sChessMove UnpackMove(PackedMove const    packedMove,
+                      ChessPosition const& position)
+{
+    uint8_t const moveCode = GetPackedMoveCode(packedMove);
+    sChessMove    move;
+
+    move.m_fromSquare   = static_cast<int8_t>(GetPackedFromSquare(packedMove));
+    move.m_toSquare     = static_cast<int8_t>(GetPackedToSquare(packedMove));
+    move.m_pieceType    = position.GetPieceType(move.m_fromSquare);
+    move.m_capturedType = position.GetPieceType(move.m_toSquare);
+
+    if (IsPackedPromotion(packedMove))
+    {
+        move.m_promotionType = PACKED_PROMOTION_TYPES[moveCode & 3];
+        if (move.IsCapture()) move.m_flag = eChessMoveFlag::CAPTURE;
+
+        return move;
+    }
+
+    switch (moveCode)
+    {
+    case PACKED_DOUBLE_PAWN_PUSH: move.m_flag = eChessMoveFlag::DOUBLE_PAWN_PUSH; break;
+    case PACKED_CASTLE_KINGSIDE:  move.m_flag = eChessMoveFlag::CASTLE_KINGSIDE; break;
+    case PACKED_CASTLE_QUEENSIDE: move.m_flag = eChessMoveFlag::CASTLE_QUEENSIDE; break;
+    case PACKED_CAPTURE:          move.m_flag = eChessMoveFlag::CAPTURE; break;
+    case PACKED_EN_PASSANT:
+        move.m_flag         = eChessMoveFlag::EN_PASSANT;
+        move.m_capturedType = ePieceType::PAWN;
+        break;
+    default: break;
+    }
+
+    return move;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return Algebraic square name such as "e4", or "-" for INVALID_SQUARE.
+std::string GetSquareName(int const square)
+{
+    if (square < 0 || square >= NUM_SQUARES) return "-";
+
+    std::string squareName;
+    squareName += static_cast<char>('a' + GetFile(square));
+    squareName += static_cast<char>('1' + GetRank(square));
+
+    return squareName;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Reverses GetSquareName; the file letter may be upper or lower case.
+/// @return INVALID_SQUARE unless squareName is exactly a file letter followed by a rank digit.
+int GetSquareFromName(std::string const& squareName)
+{
+    if (squareName.size() != 2) return INVALID_SQUARE;
+
+    int const file = (squareName[0] | 0x20) - 'a';
+    int const rank = squareName[1] - '1';
+
+    if (file < 0 || file > 7 || rank < 0 || rank > 7) return INVALID_SQUARE;
+
+    return GetSquare(file, rank);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return Long algebraic (UCI) notation such as "e2e4" or "e7e8q".
+std::string GetMoveNotation(sChessMove const& move)
+{
+    std::string notation = GetSquareName(move.m_fromSquare) + GetSquareName(move.m_toSquare);
+
+    switch (move.m_promotionType)
+    {
+    case ePieceType::QUEEN: notation += 'q'; break;
+    case ePieceType::ROOK: notation += 'r'; break;
+    case ePieceType::BISHOP: notation += 'b'; break;
+    case ePieceType::KNIGHT: notation += 'n'; break;
+    default: break;
+    }
+
+    return notation;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Reverses GetMoveNotation against a move list, typically the legal moves of a position.
+/// A promotion only matches when its piece letter is given.
+/// @return The move in moves that the notation spells, or nullptr if it is malformed or not in the list.
+sChessMove const* FindMoveByNotation(MoveList const&    moves,
+                                     std::string const& notation)
+{
+    if (notation.size() != 4 && notation.size() != 5) return nullptr;
+
+    int const fromSquare = GetSquareFromName(notation.substr(0, 2));
+    int const toSquare   = GetSquareFromName(notation.substr(2, 2));
+
+    if (fromSquare == INVALID_SQUARE || toSquare == INVALID_SQUARE) return nullptr;
+
+    ePieceType promotionType = ePieceType::NONE;
+
+    if (notation.size() == 5)
+    {
+        switch (notation[4] | 0x20)
+        {
+        case 'q': promotionType = ePieceType::QUEEN; break;
+        case 'r': promotionType = ePieceType::ROOK; break;
+        case 'b': promotionType = ePieceType::BISHOP; break;
+        case 'n': promotionType = ePieceType::KNIGHT; break;
+        default: return nullptr;
+        }
+    }
+
+    for (sChessMove const& move : moves)
+    {
+        if (move.m_fromSquare == fromSquare && move.m_toSquare == toSquare && move.m_promotionType == promotionType) return &move;
+    }
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return Name matching Match::IsValidPromotionType, or "" if the type cannot be promoted to.
+char const* GetPromotionTypeName(ePieceType const pieceType)
+{
+    switch (pieceType)
+    {
+    case ePieceType::QUEEN: return "queen";
+    case ePieceType::ROOK: return "rook";
+    case ePieceType::BISHOP: return "bishop";
+    case ePieceType::KNIGHT: return "knight";
+    default: return "";
+    }
+}
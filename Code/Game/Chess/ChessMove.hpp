@@ -0,0 +1,144 @@
+//----------------------------------------------------------------------------------------------------
+// ChessMove.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cassert>
+#include <string>
+
+#include "Game/Chess/ChessCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class ChessPosition;
+
+//----------------------------------------------------------------------------------------------------
+enum class eChessMoveFlag : uint8_t
+{
+    QUIET,
+    DOUBLE_PAWN_PUSH,
+    CAPTURE,
+    EN_PASSANT,
+    CASTLE_KINGSIDE,
+    CASTLE_QUEENSIDE
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// A fully described move as emitted by the move generator. Squares are 0-based (a1 = 0, h8 = 63).
+/// m_promotionType is NONE unless a pawn reaches the last rank; promotions may also be captures.
+struct sChessMove
+{
+    int8_t         m_fromSquare    = INVALID_SQUARE;
+    int8_t         m_toSquare      = INVALID_SQUARE;
+    ePieceType     m_pieceType     = ePieceType::NONE;
+    ePieceType     m_capturedType  = ePieceType::NONE;
+    ePieceType     m_promotionType = ePieceType::NONE;
+    eChessMoveFlag m_flag          = eChessMoveFlag::QUIET;
+
+    bool IsCapture() const { return m_capturedType != ePieceType::NONE; }
+    bool IsPromotion() const { return m_promotionType != ePieceType::NONE; }
+    bool IsCastling() const { return m_flag == eChessMoveFlag::CASTLE_KINGSIDE || m_flag == eChessMoveFlag::CASTLE_QUEENSIDE; }
+
+    bool operator==(sChessMove const& compare) const;
+    bool operator!=(sChessMove const& compare) const;
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// A move in 16 bits for history, tables and search: bits 0-5 hold the from square, bits 6-11 the to
+/// square and bits 12-15 a PACKED_* move code. Piece and captured types are not stored; UnpackMove
+/// reads them from the position the move is played in. 0 (a1a1) is never legal and means "no move".
+typedef uint16_t PackedMove;
+
+PackedMove constexpr NULL_PACKED_MOVE = 0;
+
+//----------------------------------------------------------------------------------------------------
+// Move codes. Promotions set PACKED_PROMOTION, plus PACKED_CAPTURE when they capture, with the
+// promoted piece (knight, bishop, rook, queen) in the low two bits.
+uint8_t constexpr PACKED_QUIET            = 0;
+uint8_t constexpr PACKED_DOUBLE_PAWN_PUSH = 1;
+uint8_t constexpr PACKED_CASTLE_KINGSIDE  = 2;
+uint8_t constexpr PACKED_CASTLE_QUEENSIDE = 3;
+uint8_t constexpr PACKED_CAPTURE          = 4;
+uint8_t constexpr PACKED_EN_PASSANT       = 5;
+uint8_t constexpr PACKED_PROMOTION        = 8;
+
+//----------------------------------------------------------------------------------------------------
+constexpr int     GetPackedFromSquare(PackedMove const move) { return move & 63; }
+constexpr int     GetPackedToSquare(PackedMove const move) { return (move >> 6) & 63; }
+constexpr uint8_t GetPackedMoveCode(PackedMove const move) { return static_cast<uint8_t>(move >> 12); }
+constexpr bool    IsPackedPromotion(PackedMove const move) { return (GetPackedMoveCode(move) & PACKED_PROMOTION) != 0; }
+constexpr bool    IsPackedCapture(PackedMove const move) { return (GetPackedMoveCode(move) & PACKED_CAPTURE) != 0; }
+
+//----------------------------------------------------------------------------------------------------
+int constexpr MAX_MOVES = 256;    // No legal position has more than 218 moves
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Fixed-capacity move list that lives on the stack and never allocates, so move generation and
+/// search do no heap traffic. Generators append, so one list can collect several passes.
+class MoveList
+{
+public:
+    void Push(sChessMove const& move)
+    {
+        assert(m_size < MAX_MOVES);
+        m_moves[m_size++] = move;
+    }
+
+    void Resize(int const size)
+    {
+        assert(size >= 0 && size <= m_size);
+        m_size = size;
+    }
+
+    sChessMove&       operator[](int const index) { return m_moves[index]; }
+    sChessMove const& operator[](int const index) const { return m_moves[index]; }
+    sChessMove&       GetBack() { return m_moves[m_size - 1]; }
+    int               GetSize() const { return m_size; }
+    bool              IsEmpty() const { return m_size == 0; }
+    void              Clear() { m_size = 0; }
+
+    // Range-for support
+    sChessMove*       begin() { return m_moves; }
+    sChessMove*       end() { return m_moves + m_size; }
+    sChessMove const* begin() const { return m_moves; }
+    sChessMove const* end() const { return m_moves + m_size; }
+
+private:
+    sChessMove m_moves[MAX_MOVES];
+    int        m_size = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The state ChessPosition::MakeMove cannot recompute, or that is cheaper to restore than to
+/// recompute, when the move is taken back.
+struct sUndoState
+{
+    ePieceType m_capturedType            = ePieceType::NONE;
+    uint8_t    m_castlingRights          = CASTLE_NONE;
+    int8_t     m_enPassantSquare         = INVALID_SQUARE;
+    uint16_t   m_halfmoveClock           = 0;
+    uint8_t    m_validAttackMapMask      = 0;
+    Bitboard   m_attackMaps[NUM_PLAYERS] = {};
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief A move made on a ChessPosition, with the state needed to take it back.
+struct sUndoEntry
+{
+    sChessMove m_move;
+    sUndoState m_undoState;
+};
+
+//----------------------------------------------------------------------------------------------------
+PackedMove PackMove(sChessMove const& move);
+sChessMove UnpackMove(PackedMove packedMove, ChessPosition const& position);
+
+//----------------------------------------------------------------------------------------------------
+std::string       GetSquareName(int square);
+int               GetSquareFromName(std::string const& squareName);
+std::string       GetMoveNotation(sChessMove const& move);
+sChessMove const* FindMoveByNotation(MoveList const& moves, std::string const& notation);
+char const*       GetPromotionTypeName(ePieceType pieceType);
@@ -0,0 +1,71 @@
+//----------------------------------------------------------------------------------------------------
+// ChessMoveCache.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessMoveCache.hpp"
+
+#include "Game/Chess/ChessPosition.hpp"
+#include "Game/Chess/MoveGenerator.hpp"
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Regenerates the move list unless it already belongs to the position.
+void ChessMoveCache::Refresh(ChessPosition const& position)
+{
+    if (m_isValid && m_hash == position.GetHash()) return;
+
+    m_legalMoves.Clear();
+    GenerateLegalMoves(position, m_legalMoves);
+
+    for (Bitboard& destinations : m_destinations)
+    {
+        destinations = 0;
+    }
+
+    for (sChessMove const& move : m_legalMoves)
+    {
+        m_destinations[move.m_fromSquare] |= GetSquareBit(move.m_toSquare);
+    }
+
+    m_hash    = position.GetHash();
+    m_isValid = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+MoveList const& ChessMoveCache::GetLegalMoves(ChessPosition const& position)
+{
+    Refresh(position);
+    return m_legalMoves;
+}
+
+//----------------------------------------------------------------------------------------------------
+Bitboard ChessMoveCache::GetDestinations(ChessPosition const& position,
+                                         int const            fromSquare)
+{
+    Refresh(position);
+    return m_destinations[fromSquare];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return The legal move between the squares, or nullptr if there is none. promotionType picks among
+/// the four promotions and is ignored for every other move. The pointer is valid until the next
+/// lookup for a different position.
+sChessMove const* ChessMoveCache::FindMove(ChessPosition const& position,
+                                           int const            fromSquare,
+                                           int const            toSquare,
+                                           ePieceType const     promotionType)
+{
+    Refresh(position);
+
+    if ((m_destinations[fromSquare] & GetSquareBit(toSquare)) == 0) return nullptr;
+
+    for (sChessMove const& move : m_legalMoves)
+    {
+        if (move.m_fromSquare != fromSquare || move.m_toSquare != toSquare) continue;
+        if (move.IsPromotion() && move.m_promotionType != promotionType) continue;
+
+        return &move;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,38 @@
+//----------------------------------------------------------------------------------------------------
+// ChessMoveCache.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+#include "Game/Chess/ChessMove.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class ChessPosition;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// The legal moves of one position, keyed by its Zobrist hash, so the mouse, network validation and
+/// the AI answer legality questions from a single generator pass per ply. Every lookup takes the
+/// position it asks about and regenerates the list if the hash differs, so a stale entry is never
+/// served. Not thread-safe; search threads should copy GetLegalMoves rather than share the cache.
+class ChessMoveCache
+{
+public:
+    void Refresh(ChessPosition const& position);
+    void Clear() { m_isValid = false; }
+
+    MoveList const&   GetLegalMoves(ChessPosition const& position);
+    Bitboard          GetDestinations(ChessPosition const& position, int fromSquare);
+    sChessMove const* FindMove(ChessPosition const& position, int fromSquare, int toSquare, ePieceType promotionType = ePieceType::QUEEN);
+
+    bool     IsValid() const { return m_isValid; }
+    uint64_t GetHash() const { return m_hash; }
+
+private:
+    MoveList m_legalMoves;
+    Bitboard m_destinations[NUM_SQUARES] = {};   // Per source square, the squares its legal moves reach
+    uint64_t m_hash                      = 0;
+    bool     m_isValid                   = false;
+};
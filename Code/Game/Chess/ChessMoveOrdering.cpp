@@ -0,0 +1,385 @@
+//----------------------------------------------------------------------------------------------------
+// ChessMoveOrdering.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessMoveOrdering.hpp"
+
+#include <algorithm>
+
+#include "Game/Chess/ChessAttacks.hpp"
+#include "Game/Chess/ChessEvaluation.hpp"
+#include "Game/Chess/ChessPosition.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    // Indexed by ePieceType. Unlike PIECE_VALUES the king is worth the most, so it recaptures last.
+    int constexpr EXCHANGE_VALUES[NUM_PIECE_TYPES] = {100, 330, 320, 500, 900, 20000};
+
+    // Least valuable attacker first
+    ePieceType constexpr ATTACKER_ORDER[NUM_PIECE_TYPES] = {ePieceType::PAWN, ePieceType::KNIGHT, ePieceType::BISHOP, ePieceType::ROOK, ePieceType::QUEEN, ePieceType::KING};
+
+    int constexpr MAX_EXCHANGE_DEPTH = 32;
+
+    //------------------------------------------------------------------------------------------------
+    int GetExchangeValue(ePieceType const pieceType) { return pieceType == ePieceType::NONE ? 0 : EXCHANGE_VALUES[static_cast<int>(pieceType)]; }
+
+    //------------------------------------------------------------------------------------------------
+    bool IsQuietMove(sChessMove const& move) { return !move.IsCapture() && !move.IsPromotion(); }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Every piece of either side that attacks square through the given occupancy.
+    Bitboard GetAttackersTo(ChessPosition const& position,
+                            int const            square,
+                            Bitboard const       occupancy)
+    {
+        Bitboard const bishopsAndQueens = position.GetPieces(0, ePieceType::BISHOP) | position.GetPieces(1, ePieceType::BISHOP) |
+            position.GetPieces(0, ePieceType::QUEEN) | position.GetPieces(1, ePieceType::QUEEN);
+        Bitboard const rooksAndQueens = position.GetPieces(0, ePieceType::ROOK) | position.GetPieces(1, ePieceType::ROOK) |
+            position.GetPieces(0, ePieceType::QUEEN) | position.GetPieces(1, ePieceType::QUEEN);
+
+        // A pawn of player p attacks square exactly when a pawn of the other player on square would attack it
+        return (GetPawnAttacks(square, 1) & position.GetPieces(0, ePieceType::PAWN)) |
+            (GetPawnAttacks(square, 0) & position.GetPieces(1, ePieceType::PAWN)) |
+            (GetKnightAttacks(square) & (position.GetPieces(0, ePieceType::KNIGHT) | position.GetPieces(1, ePieceType::KNIGHT))) |
+            (GetKingAttacks(square) & (position.GetPieces(0, ePieceType::KING) | position.GetPieces(1, ePieceType::KING))) |
+            (GetBishopAttacks(square, occupancy) & bishopsAndQueens) |
+            (GetRookAttacks(square, occupancy) & rooksAndQueens);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int GetStaticExchangeScore(ChessPosition const& position,
+                           sChessMove const&    move)
+{
+    // The captured pawn is not on the target square, and pawn takes pawn never loses material
+    if (move.m_flag == eChessMoveFlag::EN_PASSANT) return 0;
+
+    int const toSquare = move.m_toSquare;
+    int       gains[MAX_EXCHANGE_DEPTH];
+    int       exchangeDepth = 0;
+
+    gains[0] = GetExchangeValue(move.m_capturedType);
+
+    ePieceType attackerType = move.m_pieceType;
+
+    if (move.IsPromotion())
+    {
+        gains[0] += GetExchangeValue(move.m_promotionType) - GetExchangeValue(ePieceType::PAWN);
+        attackerType = move.m_promotionType;
+    }
+
+    Bitboard occupancy = position.GetOccupancy() ^ GetSquareBit(move.m_fromSquare);
+    Bitboard attackers = GetAttackersTo(position, toSquare, occupancy) & occupancy;
+    int      sideId    = position.GetSideToMove();
+
+    while (exchangeDepth + 1 < MAX_EXCHANGE_DEPTH)
+    {
+        sideId = GetOpponentId(sideId);
+
+        Bitboard const sideAttackers = attackers & position.GetPlayerOccupancy(sideId);
+
+        if (sideAttackers == 0) break;
+
+        // The king may only recapture when nothing defends the square any more
+        ePieceType nextAttackerType = ePieceType::NONE;
+        Bitboard   nextAttackerBit  = 0;
+
+        for (ePieceType const pieceType : ATTACKER_ORDER)
+        {
+            Bitboard const pieces = sideAttackers & position.GetPieces(sideId, pieceType);
+
+            if (pieces == 0) continue;
+
+            nextAttackerType = pieceType;
+            nextAttackerBit  = pieces & (~pieces + 1);
+            break;
+        }
+
+        if (nextAttackerType == ePieceType::KING && (attackers & position.GetPlayerOccupancy(GetOpponentId(sideId)) & ~nextAttackerBit) != 0) break;
+
+        ++exchangeDepth;
+        gains[exchangeDepth] = GetExchangeValue(attackerType) - gains[exchangeDepth - 1];
+
+        // Neither side can come out ahead of standing pat from here on
+        if (std::max(-gains[exchangeDepth - 1], gains[exchangeDepth]) < 0) break;
+
+        attackerType = nextAttackerType;
+        occupancy ^= nextAttackerBit;
+
+        // Removing the attacker may uncover a slider behind it
+        attackers = GetAttackersTo(position, toSquare, occupancy) & occupancy;
+    }
+
+    while (exchangeDepth > 0)
+    {
+        gains[exchangeDepth - 1] = -std::max(-gains[exchangeDepth - 1], gains[exchangeDepth]);
+        --exchangeDepth;
+    }
+
+    return gains[0];
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessMoveOrderTables::Clear()
+{
+    *this = ChessMoveOrderTables();
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessMoveOrderTables::PrepareSearch()
+{
+    for (PackedMove (&killers)[2] : m_killers)
+    {
+        killers[0] = NULL_PACKED_MOVE;
+        killers[1] = NULL_PACKED_MOVE;
+    }
+
+    for (auto& playerHistory : m_history)
+    {
+        for (auto& fromHistory : playerHistory)
+        {
+            for (int& score : fromHistory) score /= 2;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The previous move's piece now stands on its target square, so the position tells which
+/// piece moved, including the promoted piece after a promotion.
+PackedMove ChessMoveOrderTables::GetCountermove(ChessPosition const& position,
+                                                PackedMove const     previousMove) const
+{
+    if (previousMove == NULL_PACKED_MOVE) return NULL_PACKED_MOVE;
+
+    int const        toSquare  = GetPackedToSquare(previousMove);
+    ePieceType const pieceType = position.GetPieceType(toSquare);
+
+    return pieceType == ePieceType::NONE ? NULL_PACKED_MOVE : m_countermoves[static_cast<int>(pieceType)][toSquare];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Records a quiet move that caused a beta cutoff at ply, and punishes the quiet moves searched
+/// before it at the same node, which did not.
+void ChessMoveOrderTables::UpdateOnCutoff(ChessPosition const& position,
+                                          PackedMove const     move,
+                                          int const            ply,
+                                          int const            depth,
+                                          PackedMove const     previousMove,
+                                          PackedMove const*    failedQuietMoves,
+                                          int const            failedQuietCount)
+{
+    if (ply < MAX_KILLER_PLY && m_killers[ply][0] != move)
+    {
+        m_killers[ply][1] = m_killers[ply][0];
+        m_killers[ply][0] = move;
+    }
+
+    int const playerId = position.GetSideToMove();
+    int const bonus    = std::min(depth * depth, 400);
+
+    AddHistoryBonus(playerId, move, bonus);
+
+    for (int failedIndex = 0; failedIndex < failedQuietCount; ++failedIndex)
+    {
+        AddHistoryBonus(playerId, failedQuietMoves[failedIndex], -bonus);
+    }
+
+    if (previousMove == NULL_PACKED_MOVE) return;
+
+    int const        previousToSquare  = GetPackedToSquare(previousMove);
+    ePieceType const previousPieceType = position.GetPieceType(previousToSquare);
+
+    if (previousPieceType != ePieceType::NONE) m_countermoves[static_cast<int>(previousPieceType)][previousToSquare] = move;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Gravity update: the closer a score already is to the bound in the bonus's direction, the
+/// less it moves, so no score ever leaves [-MAX_HISTORY_SCORE, MAX_HISTORY_SCORE].
+void ChessMoveOrderTables::AddHistoryBonus(int const        playerId,
+                                           PackedMove const move,
+                                           int const        bonus)
+{
+    int& score = m_history[playerId][GetPackedFromSquare(move)][GetPackedToSquare(move)];
+
+    score += bonus - score * (bonus < 0 ? -bonus : bonus) / MAX_HISTORY_SCORE;
+}
+
+//----------------------------------------------------------------------------------------------------
+ChessMovePicker::ChessMovePicker(ChessPosition const&        position,
+                                 MoveList&                   moves,
+                                 PackedMove const            pvMove,
+                                 PackedMove const            ttMove,
+                                 ChessMoveOrderTables const* orderTables,
+                                 int const                   ply,
+                                 PackedMove const            previousMove)
+    : m_position(position),
+      m_moves(moves),
+      m_orderTables(orderTables),
+      m_ply(ply),
+      m_previousMove(previousMove),
+      m_pvMove(pvMove),
+      m_ttMove(ttMove)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Returns false once every move has been handed out.
+bool ChessMovePicker::GetNextMove(sChessMove& move)
+{
+    for (;;)
+    {
+        switch (m_stage)
+        {
+        case eStage::PV_MOVE:
+            m_stage = eStage::TT_MOVE;
+            if (TakeMove(m_pvMove, move)) return true;
+            break;
+
+        case eStage::TT_MOVE:
+            m_stage = eStage::TACTICAL_INIT;
+            if (TakeMove(m_ttMove, move)) return true;
+            break;
+
+        case eStage::TACTICAL_INIT:
+            {
+                // Gather captures and promotions at the front of what is left
+                m_tacticalEnd = m_index;
+
+                for (int moveIndex = m_index; moveIndex < m_moves.GetSize(); ++moveIndex)
+                {
+                    if (IsQuietMove(m_moves[moveIndex])) continue;
+
+                    std::swap(m_moves[moveIndex], m_moves[m_tacticalEnd]);
+
+                    sChessMove const& tacticalMove = m_moves[m_tacticalEnd];
+                    m_scores[m_tacticalEnd]        = (GetPieceValue(tacticalMove.m_capturedType) + GetPieceValue(tacticalMove.m_promotionType)) * 10 -
+                        GetPieceValue(tacticalMove.m_pieceType) / 10;
+                    ++m_tacticalEnd;
+                }
+
+                m_stage = eStage::GOOD_TACTICAL;
+                break;
+            }
+
+        case eStage::GOOD_TACTICAL:
+            while (m_index < m_tacticalEnd)
+            {
+                PickBestMove(m_tacticalEnd);
+
+                sChessMove const& tacticalMove = m_moves[m_index];
+
+                // Taking a piece worth at least the capturer cannot lose material, so only the rest need an exchange check
+                bool const isLosing = tacticalMove.IsCapture() && !tacticalMove.IsPromotion() &&
+                    GetPieceValue(tacticalMove.m_capturedType) < GetPieceValue(tacticalMove.m_pieceType) &&
+                    GetStaticExchangeScore(m_position, tacticalMove) < 0;
+
+                if (isLosing)
+                {
+                    m_badCaptureIndices[m_badCaptureCount++] = m_index++;
+                    continue;
+                }
+
+                move = m_moves[m_index++];
+                return true;
+            }
+
+            m_stage = m_orderTables != nullptr ? eStage::FIRST_KILLER : eStage::QUIET_INIT;
+            break;
+
+        case eStage::FIRST_KILLER:
+            m_stage = eStage::SECOND_KILLER;
+            if (m_ply < MAX_KILLER_PLY && TakeMove(m_orderTables->GetKiller(m_ply, 0), move)) return true;
+            break;
+
+        case eStage::SECOND_KILLER:
+            m_stage = eStage::COUNTERMOVE;
+            if (m_ply < MAX_KILLER_PLY && TakeMove(m_orderTables->GetKiller(m_ply, 1), move)) return true;
+            break;
+
+        case eStage::COUNTERMOVE:
+            m_stage = eStage::QUIET_INIT;
+            if (TakeMove(m_orderTables->GetCountermove(m_position, m_previousMove), move)) return true;
+            break;
+
+        case eStage::QUIET_INIT:
+            {
+                int const playerId = m_position.GetSideToMove();
+
+                for (int moveIndex = m_index; moveIndex < m_moves.GetSize(); ++moveIndex)
+                {
+                    m_scores[moveIndex] = m_orderTables != nullptr ? m_orderTables->GetHistoryScore(playerId, PackMove(m_moves[moveIndex])) : 0;
+                }
+
+                m_stage = eStage::QUIETS;
+                break;
+            }
+
+        case eStage::QUIETS:
+            if (m_index < m_moves.GetSize())
+            {
+                PickBestMove(m_moves.GetSize());
+                move = m_moves[m_index++];
+                return true;
+            }
+
+            m_stage = eStage::BAD_CAPTURES;
+            break;
+
+        case eStage::BAD_CAPTURES:
+            if (m_badCaptureIndex < m_badCaptureCount)
+            {
+                move = m_moves[m_badCaptureIndices[m_badCaptureIndex++]];
+                return true;
+            }
+
+            m_stage = eStage::DONE;
+            break;
+
+        case eStage::DONE:
+        default:
+            return false;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Hands out packedMove if it is among the moves not yet handed out. Stages 1 and 3 search
+/// the rest of the list, which in stage 3 holds only quiet moves, so a killer that is now a capture
+/// is not found twice.
+bool ChessMovePicker::TakeMove(PackedMove const packedMove,
+                               sChessMove&      move)
+{
+    if (packedMove == NULL_PACKED_MOVE) return false;
+
+    for (int moveIndex = m_index; moveIndex < m_moves.GetSize(); ++moveIndex)
+    {
+        if (PackMove(m_moves[moveIndex]) != packedMove) continue;
+
+        std::swap(m_moves[moveIndex], m_moves[m_index]);
+        move = m_moves[m_index++];
+        return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Moves the best-scored move in [m_index, endIndex) to m_index. A selection step per move is
+/// cheaper than a full sort when a cutoff ends the loop after the first few moves.
+void ChessMovePicker::PickBestMove(int const endIndex)
+{
+    int bestIndex = m_index;
+
+    for (int candidateIndex = m_index + 1; candidateIndex < endIndex; ++candidateIndex)
+    {
+        if (m_scores[candidateIndex] > m_scores[bestIndex]) bestIndex = candidateIndex;
+    }
+
+    if (bestIndex == m_index) return;
+
+    std::swap(m_moves[m_index], m_moves[bestIndex]);
+    std::swap(m_scores[m_index], m_scores[bestIndex]);
+}
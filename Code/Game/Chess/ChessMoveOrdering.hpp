@@ -0,0 +1,114 @@
+//----------------------------------------------------------------------------------------------------
+// ChessMoveOrdering.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+#include "Game/Chess/ChessMove.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class ChessPosition;
+
+//----------------------------------------------------------------------------------------------------
+int constexpr MAX_KILLER_PLY    = 128;      // One killer pair per search ply; must cover MAX_SEARCH_PLY
+int constexpr MAX_HISTORY_SCORE = 16384;    // History scores stay within +-this
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Material the side making the move ends up with after both sides trade on the target square,
+/// each always recapturing with its least valuable piece and free to stop when that is better. Sliders
+/// behind the capturing pieces join in as the pieces in front of them leave. Pins are ignored.
+int GetStaticExchangeScore(ChessPosition const& position, sChessMove const& move);
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// What the search learns about quiet moves, used to order them in later nodes:
+/// - killers: the last two quiet moves that caused a beta cutoff at each ply.
+/// - butterfly history: a score per side, from square and to square, raised by the square of the
+///   depth for a move that cut off and lowered for the quiet moves tried before it. A gravity term
+///   keeps the scores within MAX_HISTORY_SCORE.
+/// - countermoves: the quiet move that last refuted a move, indexed by the piece that moved and the
+///   square it moved to.
+///
+/// Killers only mean something within one search; history and countermoves carry over to the next
+/// move, with history halved so new results soon outweigh old ones.
+class ChessMoveOrderTables
+{
+public:
+    void Clear();
+    void PrepareSearch();
+
+    PackedMove GetKiller(int const ply, int const slot) const { return m_killers[ply][slot]; }
+    PackedMove GetCountermove(ChessPosition const& position, PackedMove previousMove) const;
+    int        GetHistoryScore(int const playerId, PackedMove const move) const { return m_history[playerId][GetPackedFromSquare(move)][GetPackedToSquare(move)]; }
+
+    void UpdateOnCutoff(ChessPosition const& position, PackedMove move, int ply, int depth, PackedMove previousMove, PackedMove const* failedQuietMoves, int failedQuietCount);
+
+private:
+    void AddHistoryBonus(int playerId, PackedMove move, int bonus);
+
+    PackedMove m_killers[MAX_KILLER_PLY][2]                    = {};
+    int        m_history[NUM_PLAYERS][NUM_SQUARES][NUM_SQUARES] = {};
+    PackedMove m_countermoves[NUM_PIECE_TYPES][NUM_SQUARES]     = {};
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Hands out the moves of a generated legal list best-first, in stages, so work on the later stages is
+/// only done if no earlier move caused a cutoff:
+/// 1. the previous iteration's PV move, then the transposition table move;
+/// 2. captures and promotions by most valuable victim, least valuable attacker; a capture that loses
+///    material by static exchange is held back until the end;
+/// 3. the two killer moves of this ply, then the countermove to the previous move;
+/// 4. the remaining quiet moves by history score;
+/// 5. the losing captures.
+/// Without order tables (quiescence), stage 3 is skipped and quiet moves keep their generated order.
+/// The list is reordered in place.
+class ChessMovePicker
+{
+public:
+    ChessMovePicker(ChessPosition const&        position,
+                    MoveList&                   moves,
+                    PackedMove                  pvMove,
+                    PackedMove                  ttMove,
+                    ChessMoveOrderTables const* orderTables,
+                    int                         ply,
+                    PackedMove                  previousMove);
+
+    bool GetNextMove(sChessMove& move);
+
+private:
+    enum class eStage : uint8_t
+    {
+        PV_MOVE,
+        TT_MOVE,
+        TACTICAL_INIT,
+        GOOD_TACTICAL,
+        FIRST_KILLER,
+        SECOND_KILLER,
+        COUNTERMOVE,
+        QUIET_INIT,
+        QUIETS,
+        BAD_CAPTURES,
+        DONE
+    };
+
+    bool TakeMove(PackedMove packedMove, sChessMove& move);
+    void PickBestMove(int endIndex);
+
+    ChessPosition const&        m_position;
+    MoveList&                   m_moves;
+    ChessMoveOrderTables const* m_orderTables;
+    int                         m_ply;
+    PackedMove                  m_previousMove;
+    PackedMove                  m_pvMove;
+    PackedMove                  m_ttMove;
+    eStage                      m_stage       = eStage::PV_MOVE;
+    int                         m_index       = 0;    // Moves before this have been handed out or held back
+    int                         m_tacticalEnd = 0;    // Captures and promotions sit in [m_index, m_tacticalEnd) during stage 2
+    int                         m_scores[MAX_MOVES];
+    int                         m_badCaptureIndices[MAX_MOVES];    // Held back moves stay in the list before m_index
+    int                         m_badCaptureCount = 0;
+    int                         m_badCaptureIndex = 0;
+};
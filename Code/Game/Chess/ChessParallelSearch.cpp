@@ -0,0 +1,80 @@
+//----------------------------------------------------------------------------------------------------
+// ChessParallelSearch.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessParallelSearch.hpp"
+
+#include "Game/Chess/ChessThreadPool.hpp"
+
+//----------------------------------------------------------------------------------------------------
+/// @param threadCount Total threads including the caller; 0 or less uses every hardware thread.
+ChessParallelSearch::ChessParallelSearch(int const                threadCount,
+                                         ChessTranspositionTable* transpositionTable)
+{
+    int totalThreadCount = threadCount > 0 ? threadCount : ChessThreadPool::GetHardwareThreadCount();
+
+    if (transpositionTable == nullptr) totalThreadCount = 1;
+
+    for (int threadIndex = 0; threadIndex < totalThreadCount; ++threadIndex)
+    {
+        m_searches.emplace_back(new ChessSearch(transpositionTable));
+    }
+
+    m_results.resize(static_cast<size_t>(totalThreadCount));
+
+    if (totalThreadCount > 1) m_threadPool.reset(new ChessThreadPool(totalThreadCount));
+}
+
+//----------------------------------------------------------------------------------------------------
+ChessParallelSearch::~ChessParallelSearch() = default;
+
+//----------------------------------------------------------------------------------------------------
+sSearchResult ChessParallelSearch::Search(ChessPosition const&    position,
+                                          ChessHashHistory const& hashHistory,
+                                          sSearchLimits const&    limits)
+{
+    if (m_threadPool == nullptr) return m_searches[0]->Search(position, hashHistory, limits);
+
+    // Helpers run until the main search is done, whatever limits stopped it
+    sSearchLimits helperLimits     = limits;
+    helperLimits.m_softTimeSeconds = 0.0;
+    helperLimits.m_hardTimeSeconds = 0.0;
+    helperLimits.m_stopFlag        = &m_isHelperStopRequested;
+
+    m_isHelperStopRequested.store(false, std::memory_order_relaxed);
+
+    // The first task handed out is always index 0, so the main search starts at once even if one
+    // thread ends up running several tasks; helpers it runs afterwards stop immediately
+    m_threadPool->ParallelFor(GetThreadCount(), [&](int const taskIndex)
+    {
+        if (taskIndex == 0)
+        {
+            m_results[0] = m_searches[0]->Search(position, hashHistory, limits);
+            m_isHelperStopRequested.store(true, std::memory_order_relaxed);
+            return;
+        }
+
+        sSearchLimits threadLimits = helperLimits;
+        threadLimits.m_startDepth  = limits.m_startDepth + (taskIndex & 1);
+
+        m_results[taskIndex] = m_searches[taskIndex]->Search(position, hashHistory, threadLimits);
+    });
+
+    sSearchResult result = m_results[0];
+
+    for (int threadIndex = 1; threadIndex < GetThreadCount(); ++threadIndex)
+    {
+        sSearchResult const& helperResult = m_results[threadIndex];
+
+        result.m_nodeCount += helperResult.m_nodeCount;
+        result.m_ttProbeCount += helperResult.m_ttProbeCount;
+        result.m_ttHitCount += helperResult.m_ttHitCount;
+        result.m_failHighCount += helperResult.m_failHighCount;
+        result.m_firstMoveFailHighCount += helperResult.m_firstMoveFailHighCount;
+
+        if (helperResult.m_selectiveDepth > result.m_selectiveDepth) result.m_selectiveDepth = helperResult.m_selectiveDepth;
+    }
+
+    return result;
+}
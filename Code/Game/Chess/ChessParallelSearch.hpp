@@ -0,0 +1,45 @@
+//----------------------------------------------------------------------------------------------------
+// ChessParallelSearch.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "Game/Chess/ChessSearch.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class ChessThreadPool;
+class ChessTranspositionTable;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Lazy SMP: every thread runs its own ChessSearch from the same root, and the threads cooperate only
+/// through the shared transposition table, where each one finds the results of the others. Helpers
+/// at odd indices start one iteration deeper so the threads do not walk the tree in lockstep. The
+/// main search (thread 0) alone follows the time limits and the caller's stop flag; its result is
+/// returned, and the helpers are stopped as soon as it finishes. Node, table and fail-high counters
+/// in the result are summed over all threads.
+///
+/// With one thread this is a plain ChessSearch with no pool. Without a transposition table the helpers
+/// would only repeat the main search, so they are not started.
+class ChessParallelSearch
+{
+public:
+    ChessParallelSearch(int threadCount, ChessTranspositionTable* transpositionTable);
+    ~ChessParallelSearch();
+
+    ChessParallelSearch(ChessParallelSearch const& copy)            = delete;
+    ChessParallelSearch& operator=(ChessParallelSearch const& copy) = delete;
+
+    sSearchResult Search(ChessPosition const& position, ChessHashHistory const& hashHistory, sSearchLimits const& limits);
+    int           GetThreadCount() const { return static_cast<int>(m_searches.size()); }
+
+private:
+    std::unique_ptr<ChessThreadPool>          m_threadPool;
+    std::vector<std::unique_ptr<ChessSearch>> m_searches;
+    std::vector<sSearchResult>                m_results;    // One per thread, so no two threads write the same slot
+    std::atomic<bool>                         m_isHelperStopRequested = {false};
+};
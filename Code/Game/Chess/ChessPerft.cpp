@@ -0,0 +1,219 @@
+//----------------------------------------------------------------------------------------------------
+// ChessPerft.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessPerft.hpp"
+
+#include <chrono>
+
+#include "Game/Chess/ChessPerftTable.hpp"
+#include "Game/Chess/ChessPosition.hpp"
+#include "Game/Chess/ChessThreadPool.hpp"
+#include "Game/Chess/MoveGenerator.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    struct sPerftTask
+    {
+        int           m_rootMoveIndex = 0;
+        int           m_depth         = 0;
+        ChessPosition m_position;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    uint64_t PerftRecursive(ChessPosition& position,
+                            int const      depth)
+    {
+        MoveList moves;
+        GenerateLegalMoves(position, moves);
+
+        // Bulk counting: the legal moves at the last ply are the leaves
+        if (depth == 1) return static_cast<uint64_t>(moves.GetSize());
+
+        uint64_t   nodeCount = 0;
+        sUndoState undoState;
+
+        for (sChessMove const& move : moves)
+        {
+            position.MakeMove(move, undoState);
+            nodeCount += PerftRecursive(position, depth - 1);
+            position.UnmakeMove(move, undoState);
+        }
+
+        return nodeCount;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    uint64_t PerftHashedRecursive(ChessPosition&   position,
+                                  int const        depth,
+                                  ChessPerftTable& perftTable)
+    {
+        // Nodes one ply from the leaves are cheaper to bulk count than to look up
+        if (depth <= 1) return PerftRecursive(position, depth);
+
+        uint64_t const hash      = position.GetHash();
+        uint64_t       nodeCount = 0;
+
+        if (perftTable.Probe(hash, depth, nodeCount)) return nodeCount;
+
+        MoveList moves;
+        GenerateLegalMoves(position, moves);
+
+        sUndoState undoState;
+
+        for (sChessMove const& move : moves)
+        {
+            position.MakeMove(move, undoState);
+            nodeCount += PerftHashedRecursive(position, depth - 1, perftTable);
+            position.UnmakeMove(move, undoState);
+        }
+
+        perftTable.Store(hash, depth, nodeCount);
+
+        return nodeCount;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    uint64_t CountNodes(ChessPosition const& position,
+                        int const            depth,
+                        ChessPerftTable*     perftTable)
+    {
+        return perftTable != nullptr ? PerftHashed(position, depth, *perftTable) : Perft(position, depth);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Splits the tree into one task per second-ply position (or per root move when depth < 3,
+    /// where the tasks would be too small to be worth splitting further) and counts them in parallel.
+    void RunThreadedDivide(ChessPosition const& position,
+                           int const            depth,
+                           ChessThreadPool&     threadPool,
+                           ChessPerftTable*     perftTable,
+                           sPerftResult&        result)
+    {
+        MoveList rootMoves;
+        GenerateLegalMoves(position, rootMoves);
+
+        std::vector<sPerftTask> tasks;
+        MoveList                secondPlyMoves;
+
+        for (int rootMoveIndex = 0; rootMoveIndex < rootMoves.GetSize(); ++rootMoveIndex)
+        {
+            sPerftTask rootTask;
+            sUndoState undoState;
+            rootTask.m_rootMoveIndex = rootMoveIndex;
+            rootTask.m_depth         = depth - 1;
+            rootTask.m_position      = position;
+            rootTask.m_position.MakeMove(rootMoves[rootMoveIndex], undoState);
+
+            if (depth < 3)
+            {
+                tasks.push_back(rootTask);
+                continue;
+            }
+
+            secondPlyMoves.Clear();
+            GenerateLegalMoves(rootTask.m_position, secondPlyMoves);
+
+            for (sChessMove const& secondPlyMove : secondPlyMoves)
+            {
+                sPerftTask secondPlyTask = rootTask;
+                secondPlyTask.m_depth    = depth - 2;
+                secondPlyTask.m_position.MakeMove(secondPlyMove, undoState);
+                tasks.push_back(secondPlyTask);
+            }
+        }
+
+        std::vector<uint64_t> taskNodeCounts(tasks.size(), 0);
+
+        threadPool.ParallelFor(static_cast<int>(tasks.size()), [&tasks, &taskNodeCounts, perftTable](int const taskIndex)
+        {
+            taskNodeCounts[taskIndex] = CountNodes(tasks[taskIndex].m_position, tasks[taskIndex].m_depth, perftTable);
+        });
+
+        // Aggregate in root move order so the output does not depend on thread scheduling
+        result.m_divideList.resize(rootMoves.GetSize());
+
+        for (int rootMoveIndex = 0; rootMoveIndex < rootMoves.GetSize(); ++rootMoveIndex)
+        {
+            result.m_divideList[rootMoveIndex].m_move = rootMoves[rootMoveIndex];
+        }
+
+        for (size_t taskIndex = 0; taskIndex < tasks.size(); ++taskIndex)
+        {
+            result.m_divideList[tasks[taskIndex].m_rootMoveIndex].m_nodeCount += taskNodeCounts[taskIndex];
+            result.m_nodeCount += taskNodeCounts[taskIndex];
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t Perft(ChessPosition const& position,
+               int const            depth)
+{
+    if (depth <= 0) return 1;
+
+    ChessPosition scratchPosition = position;
+    return PerftRecursive(scratchPosition, depth);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t PerftHashed(ChessPosition const& position,
+                     int const            depth,
+                     ChessPerftTable&     perftTable)
+{
+    if (depth <= 0) return 1;
+
+    ChessPosition scratchPosition = position;
+    return PerftHashedRecursive(scratchPosition, depth, perftTable);
+}
+
+//----------------------------------------------------------------------------------------------------
+sPerftResult RunPerft(ChessPosition const& position,
+                      int const            depth,
+                      bool const           isDivide,
+                      ChessThreadPool*     threadPool,
+                      ChessPerftTable*     perftTable)
+{
+    sPerftResult result;
+    auto const   startTime = std::chrono::steady_clock::now();
+
+    if (threadPool != nullptr && threadPool->GetThreadCount() > 1 && depth > 1)
+    {
+        RunThreadedDivide(position, depth, *threadPool, perftTable, result);
+
+        if (!isDivide) result.m_divideList.clear();
+    }
+    else if (isDivide && depth > 0)
+    {
+        MoveList      moves;
+        ChessPosition nextPosition = position;
+        sUndoState    undoState;
+
+        GenerateLegalMoves(position, moves);
+
+        for (sChessMove const& move : moves)
+        {
+            nextPosition.MakeMove(move, undoState);
+
+            sPerftDivideEntry entry;
+            entry.m_move      = move;
+            entry.m_nodeCount = CountNodes(nextPosition, depth - 1, perftTable);
+
+            result.m_nodeCount += entry.m_nodeCount;
+            result.m_divideList.push_back(entry);
+
+            nextPosition.UnmakeMove(move, undoState);
+        }
+    }
+    else
+    {
+        result.m_nodeCount = CountNodes(position, depth, perftTable);
+    }
+
+    result.m_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    return result;
+}
@@ -0,0 +1,47 @@
+//----------------------------------------------------------------------------------------------------
+// ChessPerft.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Game/Chess/ChessMove.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class ChessPerftTable;
+class ChessPosition;
+class ChessThreadPool;
+
+//----------------------------------------------------------------------------------------------------
+struct sPerftDivideEntry
+{
+    sChessMove m_move;
+    uint64_t   m_nodeCount = 0;
+};
+
+typedef std::vector<sPerftDivideEntry> PerftDivideList;
+
+//----------------------------------------------------------------------------------------------------
+struct sPerftResult
+{
+    uint64_t        m_nodeCount = 0;
+    double          m_seconds   = 0.0;
+    PerftDivideList m_divideList;   // One entry per root move, only filled when divide is requested
+
+    double GetNodesPerSecond() const { return m_seconds > 0.0 ? static_cast<double>(m_nodeCount) / m_seconds : 0.0; }
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Counts the leaf nodes of the legal move tree to the given depth. Depth 0 counts as one node.
+uint64_t Perft(ChessPosition const& position, int depth);
+
+/// @brief Perft that caches the count of every interior node by (Zobrist hash, depth), so subtrees
+/// reached again through transpositions are counted once.
+uint64_t PerftHashed(ChessPosition const& position, int depth, ChessPerftTable& perftTable);
+
+/// @brief Timed perft; with isDivide the count is also broken down per root move. With a thread pool,
+/// the subtrees below the second ply are counted in parallel; totals and divide output are identical
+/// to the single-threaded run. With a perft table, every thread shares it through PerftHashed.
+sPerftResult RunPerft(ChessPosition const& position, int depth, bool isDivide, ChessThreadPool* threadPool = nullptr, ChessPerftTable* perftTable = nullptr);
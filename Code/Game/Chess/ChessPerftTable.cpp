@@ -0,0 +1,75 @@
+//----------------------------------------------------------------------------------------------------
+// ChessPerftTable.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessPerftTable.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    uint64_t constexpr DEPTH_MASK = 0xFF;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Allocates the largest power-of-two entry count that fits in the budget (at least one entry).
+ChessPerftTable::ChessPerftTable(size_t const sizeInMegabytes)
+{
+    size_t const budgetEntryCount = sizeInMegabytes * 1024 * 1024 / sizeof(sEntry);
+
+    m_entryCount = 1;
+
+    while (m_entryCount * 2 <= budgetEntryCount)
+    {
+        m_entryCount *= 2;
+    }
+
+    m_entries.reset(new sEntry[m_entryCount]);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ChessPerftTable::Probe(uint64_t const hash,
+                            int const      depth,
+                            uint64_t&      nodeCount) const
+{
+    uint64_t const depthHash = GetDepthHash(hash, depth);
+    sEntry const&  entry     = m_entries[depthHash & (m_entryCount - 1)];
+    uint64_t const data      = entry.m_data.load(std::memory_order_relaxed);
+    uint64_t const checkKey  = entry.m_checkKey.load(std::memory_order_relaxed);
+
+    if ((checkKey ^ data) != depthHash || (data & DEPTH_MASK) != static_cast<uint64_t>(depth)) return false;
+
+    nodeCount = data >> 8;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessPerftTable::Store(uint64_t const hash,
+                            int const      depth,
+                            uint64_t const nodeCount)
+{
+    uint64_t const depthHash = GetDepthHash(hash, depth);
+    sEntry&        entry     = m_entries[depthHash & (m_entryCount - 1)];
+    uint64_t const data      = nodeCount << 8 | (static_cast<uint64_t>(depth) & DEPTH_MASK);
+
+    entry.m_checkKey.store(depthHash ^ data, std::memory_order_relaxed);
+    entry.m_data.store(data, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessPerftTable::Clear()
+{
+    for (size_t entryIndex = 0; entryIndex < m_entryCount; ++entryIndex)
+    {
+        m_entries[entryIndex].m_checkKey.store(0, std::memory_order_relaxed);
+        m_entries[entryIndex].m_data.store(0, std::memory_order_relaxed);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Mixes the depth into the hash so the same position at different depths lands in different slots.
+uint64_t ChessPerftTable::GetDepthHash(uint64_t const hash,
+                                       int const      depth) const
+{
+    return hash ^ (static_cast<uint64_t>(depth) * 0x9E3779B97F4A7C15ULL);
+}
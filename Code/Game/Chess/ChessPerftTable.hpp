@@ -0,0 +1,41 @@
+//----------------------------------------------------------------------------------------------------
+// ChessPerftTable.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Fixed-size, lock-free (hash, depth) -> node count cache shared by every perft worker. Each entry
+/// is two 64-bit words: the packed data (node count << 8 | depth) and the hash XORed with that data.
+/// A torn write from two threads storing at once fails the XOR check on probe and reads as a miss,
+/// so no locking is needed. Entries are always replaced.
+class ChessPerftTable
+{
+public:
+    explicit ChessPerftTable(size_t sizeInMegabytes);
+
+    bool Probe(uint64_t hash, int depth, uint64_t& nodeCount) const;
+    void Store(uint64_t hash, int depth, uint64_t nodeCount);
+    void Clear();
+
+    size_t GetEntryCount() const { return m_entryCount; }
+    size_t GetSizeInBytes() const { return m_entryCount * sizeof(sEntry); }
+
+private:
+    struct sEntry
+    {
+        std::atomic<uint64_t> m_checkKey = {0};
+        std::atomic<uint64_t> m_data     = {0};
+    };
+
+    uint64_t GetDepthHash(uint64_t hash, int depth) const;
+
+    std::unique_ptr<sEntry[]> m_entries;
+    size_t                    m_entryCount = 0;
+};
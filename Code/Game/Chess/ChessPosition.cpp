@@ -0,0 +1,568 @@
+//----------------------------------------------------------------------------------------------------
+// ChessPosition.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessPosition.hpp"
+
+#include <cstdlib>
+
+#include "Game/Chess/ChessAttacks.hpp"
+#include "Game/Chess/ChessZobrist.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    int constexpr WHITE_KING_START_SQUARE          = GetSquare(4, 0);
+    int constexpr WHITE_KINGSIDE_ROOK_START_SQUARE  = GetSquare(7, 0);
+    int constexpr WHITE_QUEENSIDE_ROOK_START_SQUARE = GetSquare(0, 0);
+    int constexpr BLACK_KING_START_SQUARE          = GetSquare(4, 7);
+    int constexpr BLACK_KINGSIDE_ROOK_START_SQUARE  = GetSquare(7, 7);
+    int constexpr BLACK_QUEENSIDE_ROOK_START_SQUARE = GetSquare(0, 7);
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief True when a pawn of the other side attacks the square a pusherId pawn just crossed. Only
+    /// then is the en passant square set and hashed, so a double push nobody can take back transposes
+    /// into the same position reached by other moves.
+    bool IsEnPassantCapturable(ChessPosition const& position,
+                               int const            enPassantSquare,
+                               int const            pusherId)
+    {
+        // A pawn of the capturing side attacks the square exactly when a pusher's pawn on it would attack that pawn
+        return (GetPawnAttacks(enPassantSquare, pusherId) & position.GetPieces(GetOpponentId(pusherId), ePieceType::PAWN)) != 0;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Castling rights that survive a piece leaving or arriving on the given square.
+    uint8_t GetCastlingRightsKeptBySquare(int const square)
+    {
+        switch (square)
+        {
+        case WHITE_KING_START_SQUARE: return CASTLE_ALL & ~(CASTLE_WHITE_KINGSIDE | CASTLE_WHITE_QUEENSIDE);
+        case WHITE_KINGSIDE_ROOK_START_SQUARE: return CASTLE_ALL & ~CASTLE_WHITE_KINGSIDE;
+        case WHITE_QUEENSIDE_ROOK_START_SQUARE: return CASTLE_ALL & ~CASTLE_WHITE_QUEENSIDE;
+        case BLACK_KING_START_SQUARE: return CASTLE_ALL & ~(CASTLE_BLACK_KINGSIDE | CASTLE_BLACK_QUEENSIDE);
+        case BLACK_KINGSIDE_ROOK_START_SQUARE: return CASTLE_ALL & ~CASTLE_BLACK_KINGSIDE;
+        case BLACK_QUEENSIDE_ROOK_START_SQUARE: return CASTLE_ALL & ~CASTLE_BLACK_QUEENSIDE;
+        default: return CASTLE_ALL;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+ChessPosition::ChessPosition()
+{
+    Clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessPosition::Clear()
+{
+    for (Bitboard* playerPieces : m_pieces)
+    {
+        for (int pieceType = 0; pieceType < NUM_PIECE_TYPES; ++pieceType)
+        {
+            playerPieces[pieceType] = 0;
+        }
+    }
+
+    for (ePieceType& pieceType : m_mailbox)
+    {
+        pieceType = ePieceType::NONE;
+    }
+
+    m_playerOccupancy[0] = 0;
+    m_playerOccupancy[1] = 0;
+    m_occupancy          = 0;
+    m_sideToMove         = 0;
+    m_castlingRights     = CASTLE_NONE;
+    m_enPassantSquare    = INVALID_SQUARE;
+    m_halfmoveClock      = 0;
+    m_fullmoveNumber     = 1;
+    m_validAttackMapMask = 0;
+    m_hash               = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Replaces the position with the one described by a FEN string. The halfmove and fullmove
+/// fields are optional and default to 0 and 1.
+/// @return False, leaving the position cleared, if the piece placement or side to move is malformed.
+bool ChessPosition::LoadFromFEN(std::string const& fen)
+{
+    Clear();
+
+    size_t fenIndex = 0;
+    int    file     = 0;
+    int    rank     = 7;
+
+    // 1. Piece placement, rank 8 first
+    for (; fenIndex < fen.size() && fen[fenIndex] != ' '; ++fenIndex)
+    {
+        char const fenChar = fen[fenIndex];
+
+        if (fenChar == '/')
+        {
+            if (file != 8 || rank == 0) break;
+            file = 0;
+            --rank;
+            continue;
+        }
+
+        if (fenChar >= '1' && fenChar <= '8')
+        {
+            file += fenChar - '0';
+            if (file > 8) break;
+            continue;
+        }
+
+        ePieceType pieceType = ePieceType::NONE;
+
+        switch (fenChar | 0x20)
+        {
+        case 'p': pieceType = ePieceType::PAWN; break;
+        case 'n': pieceType = ePieceType::KNIGHT; break;
+        case 'b': pieceType = ePieceType::BISHOP; break;
+        case 'r': pieceType = ePieceType::ROOK; break;
+        case 'q': pieceType = ePieceType::QUEEN; break;
+        case 'k': pieceType = ePieceType::KING; break;
+        default: break;
+        }
+
+        if (pieceType == ePieceType::NONE || file > 7) break;
+
+        AddPiece(GetSquare(file, rank), pieceType, (fenChar & 0x20) ? 1 : 0);
+        ++file;
+    }
+
+    // The move generator relies on one king per side and no pawn on a back rank
+    Bitboard const pawns         = GetPieces(0, ePieceType::PAWN) | GetPieces(1, ePieceType::PAWN);
+    bool const     isPlacementOk = PopCount(GetPieces(0, ePieceType::KING)) == 1 && PopCount(GetPieces(1, ePieceType::KING)) == 1 &&
+        (pawns & (RANK_1_BITBOARD | RANK_8_BITBOARD)) == 0;
+
+    if (fenIndex >= fen.size() || fen[fenIndex] != ' ' || file != 8 || rank != 0 || !isPlacementOk)
+    {
+        Clear();
+        return false;
+    }
+
+    // 2. Side to move
+    ++fenIndex;
+
+    if (fenIndex >= fen.size() || (fen[fenIndex] != 'w' && fen[fenIndex] != 'b'))
+    {
+        Clear();
+        return false;
+    }
+
+    SetSideToMove(fen[fenIndex] == 'w' ? 0 : 1);
+    fenIndex += 2;
+
+    // 3. Castling rights
+    uint8_t castlingRights = CASTLE_NONE;
+
+    for (; fenIndex < fen.size() && fen[fenIndex] != ' '; ++fenIndex)
+    {
+        switch (fen[fenIndex])
+        {
+        case 'K': castlingRights |= CASTLE_WHITE_KINGSIDE; break;
+        case 'Q': castlingRights |= CASTLE_WHITE_QUEENSIDE; break;
+        case 'k': castlingRights |= CASTLE_BLACK_KINGSIDE; break;
+        case 'q': castlingRights |= CASTLE_BLACK_QUEENSIDE; break;
+        default: break;
+        }
+    }
+
+    // A right whose king or rook is not on its starting square cannot be used, whatever the FEN says
+    InitializeCastlingRights();
+    SetCastlingRights(castlingRights & GetCastlingRights());
+
+    // 4. En passant square
+    ++fenIndex;
+
+    if (fenIndex + 1 < fen.size() && fen[fenIndex] >= 'a' && fen[fenIndex] <= 'h' && fen[fenIndex + 1] >= '1' && fen[fenIndex + 1] <= '8')
+    {
+        int const enPassantSquare = GetSquare(fen[fenIndex] - 'a', fen[fenIndex + 1] - '1');
+
+        // Only a square a double push just crossed can be captured on: on the pusher's third rank,
+        // with the pushed pawn in front of it and both the square and the one behind it empty
+        int const  pusherId    = GetOpponentId(m_sideToMove);
+        int const  forward     = pusherId == 0 ? 8 : -8;
+        bool const isPlausible = GetRank(enPassantSquare) == (pusherId == 0 ? 2 : 5) &&
+            (GetPieces(pusherId, ePieceType::PAWN) & GetSquareBit(enPassantSquare + forward)) != 0 &&
+            !IsOccupied(enPassantSquare) && !IsOccupied(enPassantSquare - forward);
+
+        if (!isPlausible)
+        {
+            Clear();
+            return false;
+        }
+
+        if (IsEnPassantCapturable(*this, enPassantSquare, pusherId)) SetEnPassantSquare(enPassantSquare);
+    }
+
+    // 5. Halfmove clock and fullmove number
+    fenIndex = fen.find(' ', fenIndex);
+
+    if (fenIndex != std::string::npos)
+    {
+        char* fieldEnd   = nullptr;
+        m_halfmoveClock  = static_cast<int>(strtol(fen.c_str() + fenIndex, &fieldEnd, 10));
+        m_fullmoveNumber = static_cast<int>(strtol(fieldEnd, nullptr, 10));
+
+        if (m_halfmoveClock < 0) m_halfmoveClock = 0;
+        if (m_fullmoveNumber < 1) m_fullmoveNumber = 1;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Describes the position as a FEN string with all six fields, so LoadFromFEN on the result
+/// restores the same position and hash.
+std::string ChessPosition::ToFEN() const
+{
+    std::string fen;
+    fen.reserve(96);
+
+    // 1. Piece placement, rank 8 first
+    for (int rank = 7; rank >= 0; --rank)
+    {
+        int emptyCount = 0;
+
+        for (int file = 0; file < 8; ++file)
+        {
+            int const square = GetSquare(file, rank);
+
+            if (!IsOccupied(square))
+            {
+                ++emptyCount;
+                continue;
+            }
+
+            if (emptyCount > 0) fen += static_cast<char>('0' + emptyCount);
+
+            emptyCount = 0;
+            fen += GetPieceNotation(m_mailbox[square], GetPlayerId(square));
+        }
+
+        if (emptyCount > 0) fen += static_cast<char>('0' + emptyCount);
+        if (rank > 0) fen += '/';
+    }
+
+    // 2. Side to move
+    fen += m_sideToMove == 0 ? " w " : " b ";
+
+    // 3. Castling rights
+    if (m_castlingRights == CASTLE_NONE) fen += '-';
+    if (m_castlingRights & CASTLE_WHITE_KINGSIDE) fen += 'K';
+    if (m_castlingRights & CASTLE_WHITE_QUEENSIDE) fen += 'Q';
+    if (m_castlingRights & CASTLE_BLACK_KINGSIDE) fen += 'k';
+    if (m_castlingRights & CASTLE_BLACK_QUEENSIDE) fen += 'q';
+
+    // 4. En passant square
+    fen += ' ';
+
+    if (m_enPassantSquare == INVALID_SQUARE)
+    {
+        fen += '-';
+    }
+    else
+    {
+        fen += static_cast<char>('a' + GetFile(m_enPassantSquare));
+        fen += static_cast<char>('1' + GetRank(m_enPassantSquare));
+    }
+
+    // 5. Halfmove clock and fullmove number
+    fen += ' ' + std::to_string(m_halfmoveClock) + ' ' + std::to_string(m_fullmoveNumber);
+
+    return fen;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessPosition::AddPiece(int const        square,
+                             ePieceType const pieceType,
+                             int const        playerId)
+{
+    Bitboard const squareBit = GetSquareBit(square);
+
+    m_pieces[playerId][static_cast<int>(pieceType)] |= squareBit;
+    m_playerOccupancy[playerId] |= squareBit;
+    m_occupancy |= squareBit;
+    m_mailbox[square]    = pieceType;
+    m_validAttackMapMask = 0;
+    m_hash ^= GetZobristKeys().m_pieceKeys[playerId][static_cast<int>(pieceType)][square];
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessPosition::RemovePiece(int const square)
+{
+    ePieceType const pieceType = m_mailbox[square];
+
+    if (pieceType == ePieceType::NONE) return;
+
+    Bitboard const squareBit = GetSquareBit(square);
+    int const      playerId  = GetPlayerId(square);
+
+    m_pieces[playerId][static_cast<int>(pieceType)] &= ~squareBit;
+    m_playerOccupancy[playerId] &= ~squareBit;
+    m_occupancy &= ~squareBit;
+    m_mailbox[square]    = ePieceType::NONE;
+    m_validAttackMapMask = 0;
+    m_hash ^= GetZobristKeys().m_pieceKeys[playerId][static_cast<int>(pieceType)][square];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Moves the piece on fromSquare to toSquare, removing whatever stood on toSquare.
+void ChessPosition::MovePiece(int const fromSquare,
+                              int const toSquare)
+{
+    ePieceType const pieceType = m_mailbox[fromSquare];
+
+    if (pieceType == ePieceType::NONE || fromSquare == toSquare) return;
+
+    int const playerId = GetPlayerId(fromSquare);
+
+    RemovePiece(toSquare);
+    RemovePiece(fromSquare);
+    AddPiece(toSquare, pieceType, playerId);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessPosition::ChangePieceType(int const        square,
+                                   ePieceType const newPieceType)
+{
+    int const playerId = GetPlayerId(square);
+
+    if (playerId == -1) return;
+
+    RemovePiece(square);
+    AddPiece(square, newPieceType, playerId);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessPosition::SetSideToMove(int const playerId)
+{
+    if (playerId != m_sideToMove) m_hash ^= GetZobristKeys().m_sideToMoveKey;
+
+    m_sideToMove = playerId;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessPosition::SetCastlingRights(uint8_t const castlingRights)
+{
+    sZobristKeys const& keys = GetZobristKeys();
+
+    m_hash ^= keys.m_castlingKeys[m_castlingRights] ^ keys.m_castlingKeys[castlingRights];
+    m_castlingRights = castlingRights;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessPosition::SetEnPassantSquare(int const square)
+{
+    sZobristKeys const& keys = GetZobristKeys();
+
+    if (m_enPassantSquare != INVALID_SQUARE) m_hash ^= keys.m_enPassantFileKeys[GetFile(m_enPassantSquare)];
+    if (square != INVALID_SQUARE) m_hash ^= keys.m_enPassantFileKeys[GetFile(square)];
+
+    m_enPassantSquare = square;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Grants every castling right whose king and rook still stand on their starting squares.
+void ChessPosition::InitializeCastlingRights()
+{
+    Bitboard const whiteKings = GetPieces(0, ePieceType::KING);
+    Bitboard const whiteRooks = GetPieces(0, ePieceType::ROOK);
+    Bitboard const blackKings = GetPieces(1, ePieceType::KING);
+    Bitboard const blackRooks = GetPieces(1, ePieceType::ROOK);
+
+    uint8_t castlingRights = CASTLE_NONE;
+
+    if (whiteKings & GetSquareBit(WHITE_KING_START_SQUARE))
+    {
+        if (whiteRooks & GetSquareBit(WHITE_KINGSIDE_ROOK_START_SQUARE)) castlingRights |= CASTLE_WHITE_KINGSIDE;
+        if (whiteRooks & GetSquareBit(WHITE_QUEENSIDE_ROOK_START_SQUARE)) castlingRights |= CASTLE_WHITE_QUEENSIDE;
+    }
+
+    if (blackKings & GetSquareBit(BLACK_KING_START_SQUARE))
+    {
+        if (blackRooks & GetSquareBit(BLACK_KINGSIDE_ROOK_START_SQUARE)) castlingRights |= CASTLE_BLACK_KINGSIDE;
+        if (blackRooks & GetSquareBit(BLACK_QUEENSIDE_ROOK_START_SQUARE)) castlingRights |= CASTLE_BLACK_QUEENSIDE;
+    }
+
+    SetCastlingRights(castlingRights);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Drops the castling rights lost by a move that leaves fromSquare and lands on toSquare,
+/// i.e. a king or rook moving away from its starting square, or a rook being captured on it.
+void ChessPosition::RevokeCastlingRights(int const fromSquare,
+                                         int const toSquare)
+{
+    uint8_t const keptRights = GetCastlingRightsKeptBySquare(fromSquare) & GetCastlingRightsKeptBySquare(toSquare);
+
+    if ((m_castlingRights & keptRights) != m_castlingRights)
+    {
+        SetCastlingRights(m_castlingRights & keptRights);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Plays a move for the side to move and records in undoState what UnmakeMove needs to take it
+/// back. The move is assumed to be at least pseudo-legal; no validation is done here.
+void ChessPosition::MakeMove(sChessMove const& move,
+                             sUndoState&       undoState)
+{
+    int const fromSquare = move.m_fromSquare;
+    int const toSquare   = move.m_toSquare;
+
+    undoState.m_capturedType    = move.m_flag == eChessMoveFlag::EN_PASSANT ? ePieceType::PAWN : m_mailbox[toSquare];
+    undoState.m_castlingRights  = m_castlingRights;
+    undoState.m_enPassantSquare = static_cast<int8_t>(m_enPassantSquare);
+    undoState.m_halfmoveClock   = static_cast<uint16_t>(m_halfmoveClock);
+
+    undoState.m_validAttackMapMask = m_validAttackMapMask;
+    undoState.m_attackMaps[0]      = m_attackMaps[0];
+    undoState.m_attackMaps[1]      = m_attackMaps[1];
+
+    bool const isResettingHalfmoveClock = undoState.m_capturedType != ePieceType::NONE || m_mailbox[fromSquare] == ePieceType::PAWN;
+
+    switch (move.m_flag)
+    {
+    case eChessMoveFlag::EN_PASSANT:
+        RemovePiece(GetSquare(GetFile(toSquare), GetRank(fromSquare)));
+        MovePiece(fromSquare, toSquare);
+        break;
+
+    case eChessMoveFlag::CASTLE_KINGSIDE:
+        MovePiece(fromSquare, toSquare);
+        MovePiece(toSquare + 1, toSquare - 1);
+        break;
+
+    case eChessMoveFlag::CASTLE_QUEENSIDE:
+        MovePiece(fromSquare, toSquare);
+        MovePiece(toSquare - 2, toSquare + 1);
+        break;
+
+    default:
+        MovePiece(fromSquare, toSquare);
+        break;
+    }
+
+    if (move.IsPromotion())
+    {
+        ChangePieceType(toSquare, move.m_promotionType);
+    }
+
+    RevokeCastlingRights(fromSquare, toSquare);
+    int const crossedSquare = move.m_flag == eChessMoveFlag::DOUBLE_PAWN_PUSH ? (fromSquare + toSquare) / 2 : INVALID_SQUARE;
+
+    SetEnPassantSquare(crossedSquare != INVALID_SQUARE && IsEnPassantCapturable(*this, crossedSquare, m_sideToMove) ? crossedSquare : INVALID_SQUARE);
+
+    m_halfmoveClock = isResettingHalfmoveClock ? 0 : m_halfmoveClock + 1;
+
+    if (m_sideToMove == 1) ++m_fullmoveNumber;
+
+    SetSideToMove(GetOpponentId(m_sideToMove));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Takes back the last move made with MakeMove, given the undoState that call filled in.
+void ChessPosition::UnmakeMove(sChessMove const& move,
+                               sUndoState const& undoState)
+{
+    int const fromSquare = move.m_fromSquare;
+    int const toSquare   = move.m_toSquare;
+    int const moverId    = GetOpponentId(m_sideToMove);
+
+    SetSideToMove(moverId);
+
+    if (moverId == 1) --m_fullmoveNumber;
+
+    if (move.IsPromotion())
+    {
+        ChangePieceType(toSquare, ePieceType::PAWN);
+    }
+
+    switch (move.m_flag)
+    {
+    case eChessMoveFlag::EN_PASSANT:
+        MovePiece(toSquare, fromSquare);
+        AddPiece(GetSquare(GetFile(toSquare), GetRank(fromSquare)), ePieceType::PAWN, GetOpponentId(moverId));
+        break;
+
+    case eChessMoveFlag::CASTLE_KINGSIDE:
+        MovePiece(toSquare, fromSquare);
+        MovePiece(toSquare - 1, toSquare + 1);
+        break;
+
+    case eChessMoveFlag::CASTLE_QUEENSIDE:
+        MovePiece(toSquare, fromSquare);
+        MovePiece(toSquare + 1, toSquare - 2);
+        break;
+
+    default:
+        MovePiece(toSquare, fromSquare);
+
+        if (undoState.m_capturedType != ePieceType::NONE)
+        {
+            AddPiece(toSquare, undoState.m_capturedType, GetOpponentId(moverId));
+        }
+        break;
+    }
+
+    SetCastlingRights(undoState.m_castlingRights);
+    SetEnPassantSquare(undoState.m_enPassantSquare);
+    m_halfmoveClock = undoState.m_halfmoveClock;
+
+    // The pieces are back where they were, so any attack map that was current before the move is again
+    m_validAttackMapMask = undoState.m_validAttackMapMask;
+    m_attackMaps[0]      = undoState.m_attackMaps[0];
+    m_attackMaps[1]      = undoState.m_attackMaps[1];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return Owner of the piece on the square, or -1 if the square is empty.
+int ChessPosition::GetPlayerId(int const square) const
+{
+    Bitboard const squareBit = GetSquareBit(square);
+
+    if (m_playerOccupancy[0] & squareBit) return 0;
+    if (m_playerOccupancy[1] & squareBit) return 1;
+
+    return -1;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return Square of the player's king, or INVALID_SQUARE if the player has no king on the board.
+int ChessPosition::GetKingSquare(int const playerId) const
+{
+    Bitboard const kings = GetPieces(playerId, ePieceType::KING);
+
+    if (kings == 0) return INVALID_SQUARE;
+
+    return GetLowestSquare(kings);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return Squares the player attacks, computed on first use after the pieces last changed. Slider
+/// attacks see through the opposing king; see ComputeAttackedSquares.
+Bitboard ChessPosition::GetAttackedSquares(int const playerId) const
+{
+    uint8_t const playerBit = static_cast<uint8_t>(1 << playerId);
+
+    if ((m_validAttackMapMask & playerBit) == 0)
+    {
+        m_attackMaps[playerId] = ComputeAttackedSquares(*this, playerId);
+        m_validAttackMapMask |= playerBit;
+    }
+
+    return m_attackMaps[playerId];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return True if the player's king is attacked. A player without a king is never in check.
+bool ChessPosition::IsInCheck(int const playerId) const
+{
+    return (GetAttackedSquares(GetOpponentId(playerId)) & GetPieces(playerId, ePieceType::KING)) != 0;
+}
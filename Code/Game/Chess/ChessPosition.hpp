@@ -0,0 +1,74 @@
+//----------------------------------------------------------------------------------------------------
+// ChessPosition.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <string>
+
+#include "Game/Chess/ChessCommon.hpp"
+#include "Game/Chess/ChessMove.hpp"
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Bitboard representation of a chess position: one bitboard per (player, piece type), per-player
+/// occupancy, and a piece-on-square mailbox. Owned by Match, which keeps it in sync with the Piece
+/// actors inside ExecuteMove. The rules code queries this instead of scanning the piece list.
+/// Each side's attacked-square map is computed on first use after the pieces change and carried
+/// through MakeMove/UnmakeMove, so check tests against it are a single mask test. The Zobrist key is
+/// kept current with XORs by the mutators, so it always equals ComputeZobristHash(*this).
+class ChessPosition
+{
+public:
+    ChessPosition();
+
+    void        Clear();
+    bool        LoadFromFEN(std::string const& fen);
+    std::string ToFEN() const;
+
+    /// Mutators
+    void AddPiece(int square, ePieceType pieceType, int playerId);
+    void RemovePiece(int square);
+    void MovePiece(int fromSquare, int toSquare);
+    void ChangePieceType(int square, ePieceType newPieceType);
+    void SetSideToMove(int playerId);
+    void SetCastlingRights(uint8_t castlingRights);
+    void SetEnPassantSquare(int square);
+    void InitializeCastlingRights();
+    void RevokeCastlingRights(int fromSquare, int toSquare);
+    void MakeMove(sChessMove const& move, sUndoState& undoState);
+    void UnmakeMove(sChessMove const& move, sUndoState const& undoState);
+
+    /// Query
+    ePieceType GetPieceType(int const square) const { return m_mailbox[square]; }
+    bool       IsOccupied(int const square) const { return (m_occupancy & GetSquareBit(square)) != 0; }
+    bool       IsOccupiedBy(int const square, int const playerId) const { return (m_playerOccupancy[playerId] & GetSquareBit(square)) != 0; }
+    int        GetPlayerId(int square) const;
+    int        GetKingSquare(int playerId) const;
+    Bitboard   GetOccupancy() const { return m_occupancy; }
+    Bitboard   GetPlayerOccupancy(int const playerId) const { return m_playerOccupancy[playerId]; }
+    Bitboard   GetPieces(int const playerId, ePieceType const pieceType) const { return m_pieces[playerId][static_cast<int>(pieceType)]; }
+    int        GetSideToMove() const { return m_sideToMove; }
+    uint8_t    GetCastlingRights() const { return m_castlingRights; }
+    int        GetEnPassantSquare() const { return m_enPassantSquare; }
+    int        GetHalfmoveClock() const { return m_halfmoveClock; }
+    int        GetFullmoveNumber() const { return m_fullmoveNumber; }
+    uint64_t   GetHash() const { return m_hash; }
+    Bitboard   GetAttackedSquares(int playerId) const;
+    bool       IsInCheck(int playerId) const;
+
+private:
+    Bitboard   m_pieces[NUM_PLAYERS][NUM_PIECE_TYPES] = {};
+    Bitboard   m_playerOccupancy[NUM_PLAYERS]          = {};
+    Bitboard   m_occupancy                             = 0;
+    ePieceType m_mailbox[NUM_SQUARES]                  = {};
+    int        m_sideToMove                            = 0;
+    uint8_t    m_castlingRights                        = CASTLE_NONE;
+    int        m_enPassantSquare                       = INVALID_SQUARE;    // Set only when a pawn can capture en passant
+    int        m_halfmoveClock                         = 0;    // Plies since the last capture or pawn move
+    int        m_fullmoveNumber                        = 1;    // Starts at 1, incremented after black moves
+    uint64_t   m_hash                                  = 0;    // Zobrist key, updated by every mutator; see ChessZobrist.hpp
+
+    mutable Bitboard m_attackMaps[NUM_PLAYERS] = {};    // Cached ComputeAttackedSquares results
+    mutable uint8_t  m_validAttackMapMask      = 0;     // Bit playerId is set while m_attackMaps[playerId] is current
+};
@@ -0,0 +1,437 @@
+//----------------------------------------------------------------------------------------------------
+// ChessSearch.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessSearch.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Game/Chess/ChessEvaluation.hpp"
+#include "Game/Chess/ChessTranspositionTable.hpp"
+#include "Game/Chess/MoveGenerator.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    int constexpr TIME_CHECK_INTERVAL = 2048;    // Nodes between hard limit checks; a power of two
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Mate scores count plies from the root; the table stores them counted from the node, so
+    /// an entry stays right when the same position is reached at another ply.
+    int GetScoreToStore(int const score,
+                        int const ply)
+    {
+        if (score >= SCORE_MATE_BOUND) return score + ply;
+        if (score <= -SCORE_MATE_BOUND) return score - ply;
+
+        return score;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    int GetScoreFromStored(int const storedScore,
+                           int const ply)
+    {
+        if (storedScore >= SCORE_MATE_BOUND) return storedScore - ply;
+        if (storedScore <= -SCORE_MATE_BOUND) return storedScore + ply;
+
+        return storedScore;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    double GetSecondsSince(std::chrono::steady_clock::time_point const startTime)
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* GetSearchStopReasonName(eSearchStopReason const stopReason)
+{
+    switch (stopReason)
+    {
+    case eSearchStopReason::MAX_DEPTH: return "max depth";
+    case eSearchStopReason::MATE_FOUND: return "mate found";
+    case eSearchStopReason::SOFT_TIME: return "soft limit";
+    case eSearchStopReason::STABLE_MOVE: return "stable best move";
+    case eSearchStopReason::HARD_TIME: return "hard limit";
+    case eSearchStopReason::STOP_FLAG: return "stopped";
+    default: return "";
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void AllocateMoveTime(sTimeControl const& timeControl,
+                      sSearchLimits&      limits)
+{
+    limits.m_softTimeSeconds = 0.0;
+    limits.m_hardTimeSeconds = 0.0;
+
+    if (timeControl.m_remainingSeconds <= 0.0) return;
+
+    // Without a time control in sight, plan as if 30 moves remain; the share grows as the game goes on
+    int const    movesToGo    = timeControl.m_movesToGo > 0 ? std::min(timeControl.m_movesToGo, 50) : 30;
+    double const reserve      = std::min(timeControl.m_remainingSeconds * 0.05, 1.0);
+    double const usableTime   = std::max(timeControl.m_remainingSeconds - reserve, 0.01);
+    double const hardFraction = movesToGo == 1 ? 0.9 : 0.5;
+
+    limits.m_hardTimeSeconds = std::min(usableTime / movesToGo * 4.0 + timeControl.m_incrementSeconds, usableTime * hardFraction);
+    limits.m_softTimeSeconds = std::min(usableTime / movesToGo + timeControl.m_incrementSeconds * 0.75, limits.m_hardTimeSeconds);
+}
+
+//----------------------------------------------------------------------------------------------------
+ChessSearch::ChessSearch(ChessTranspositionTable* transpositionTable)
+    : m_transpositionTable(transpositionTable)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+sSearchResult ChessSearch::Search(ChessPosition const&    position,
+                                  ChessHashHistory const& hashHistory,
+                                  sSearchLimits const&    limits)
+{
+    auto const startTime = std::chrono::steady_clock::now();
+
+    m_position               = position;
+    m_hashHistory            = hashHistory;
+    m_nodeCount              = 0;
+    m_ttProbeCount           = 0;
+    m_ttHitCount             = 0;
+    m_failHighCount          = 0;
+    m_firstMoveFailHighCount = 0;
+    m_selectiveDepth         = 0;
+    m_stopFlag               = limits.m_stopFlag;
+    m_isHardTimeUp           = false;
+    m_hasHardDeadline        = limits.m_hardTimeSeconds > 0.0;
+    m_hardDeadline           = startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(limits.m_hardTimeSeconds));
+    m_previousPVLength       = 0;
+
+    m_orderTables.PrepareSearch();
+
+    int const maxDepth             = limits.m_depth < 1 ? 1 : (limits.m_depth > MAX_SEARCH_DEPTH ? MAX_SEARCH_DEPTH : limits.m_depth);
+    int       stableIterationCount = 0;    // Iterations in a row that ended on the same best move
+
+    sSearchResult result;
+
+    for (int depth = std::min(std::max(limits.m_startDepth, 1), maxDepth); depth <= maxDepth; ++depth)
+    {
+        m_isFollowingPV = true;
+
+        int const score = SearchNode(-SCORE_INFINITE, SCORE_INFINITE, depth, 0);
+
+        if (IsStopped())
+        {
+            result.m_stopReason = m_isHardTimeUp ? eSearchStopReason::HARD_TIME : eSearchStopReason::STOP_FLAG;
+            break;
+        }
+
+        // No legal move at the root: the score is already mate or stalemate, and deeper cannot change it
+        if (m_pvLength[0] == 0)
+        {
+            result.m_score = score;
+            result.m_depth = depth;
+            break;
+        }
+
+        stableIterationCount = result.HasBestMove() && m_pvTable[0][0] == result.m_bestMove ? stableIterationCount + 1 : 0;
+
+        result.m_bestMove = m_pvTable[0][0];
+        result.m_score    = score;
+        result.m_depth    = depth;
+        result.m_principalVariation.assign(m_pvTable[0], m_pvTable[0] + m_pvLength[0]);
+
+        std::copy(m_pvTable[0], m_pvTable[0] + m_pvLength[0], m_previousPV);
+        m_previousPVLength = m_pvLength[0];
+
+        if (IsMateScore(score) && SCORE_MATE - abs(score) <= depth)
+        {
+            result.m_stopReason = eSearchStopReason::MATE_FOUND;
+            break;
+        }
+
+        if (limits.m_softTimeSeconds <= 0.0) continue;
+
+        // A move that has survived several deeper searches is unlikely to change in the next one
+        double const stabilityScale = stableIterationCount >= 4 ? 0.4 : (stableIterationCount >= 2 ? 0.7 : 1.0);
+        double const elapsedSeconds = GetSecondsSince(startTime);
+
+        if (elapsedSeconds >= limits.m_softTimeSeconds)
+        {
+            result.m_stopReason = eSearchStopReason::SOFT_TIME;
+            break;
+        }
+
+        if (elapsedSeconds >= limits.m_softTimeSeconds * stabilityScale)
+        {
+            result.m_stopReason = eSearchStopReason::STABLE_MOVE;
+            break;
+        }
+    }
+
+    // Stopped before the first iteration finished: fall back on its best move so far, or any legal move
+    if (!result.HasBestMove() && m_pvLength[0] > 0) result.m_bestMove = m_pvTable[0][0];
+
+    if (!result.HasBestMove())
+    {
+        MoveList legalMoves;
+        GenerateLegalMoves(position, legalMoves);
+
+        if (!legalMoves.IsEmpty()) result.m_bestMove = legalMoves[0];
+    }
+
+    result.m_selectiveDepth         = m_selectiveDepth;
+    result.m_nodeCount              = m_nodeCount;
+    result.m_ttProbeCount           = m_ttProbeCount;
+    result.m_ttHitCount             = m_ttHitCount;
+    result.m_failHighCount          = m_failHighCount;
+    result.m_firstMoveFailHighCount = m_firstMoveFailHighCount;
+    result.m_seconds                = GetSecondsSince(startTime);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ChessSearch::SearchNode(int       alpha,
+                            int const beta,
+                            int       depth,
+                            int const ply)
+{
+    m_pvLength[ply] = 0;
+
+    int const halfmoveClock = m_position.GetHalfmoveClock();
+
+    if (ply > 0 && (halfmoveClock >= 100 || m_hashHistory.IsRepetition(halfmoveClock))) return SCORE_DRAW;
+
+    bool const isInCheck = m_position.IsInCheck(m_position.GetSideToMove());
+
+    if (isInCheck) ++depth;
+    if (depth <= 0) return SearchQuiescence(alpha, beta, ply);
+
+    if ((++m_nodeCount & (TIME_CHECK_INTERVAL - 1)) == 0) CheckHardTimeLimit();
+
+    if (ply >= MAX_SEARCH_PLY - 1) return EvaluatePosition(m_position);
+
+    uint64_t const hash        = m_position.GetHash();
+    bool const     isPVNode    = beta - alpha > 1;
+    int const      alphaOrigin = alpha;
+    PackedMove     ttMove      = NULL_PACKED_MOVE;
+
+    if (m_transpositionTable != nullptr)
+    {
+        sTTProbeResult ttEntry;
+
+        ++m_ttProbeCount;
+
+        if (m_transpositionTable->Probe(hash, ttEntry))
+        {
+            ++m_ttHitCount;
+            ttMove = ttEntry.m_move;
+
+            // PV nodes are always searched, so the principal variation is never cut short by the table
+            int const ttScore = GetScoreFromStored(ttEntry.m_score, ply);
+
+            if (!isPVNode && ply > 0 && ttEntry.m_depth >= depth &&
+                (ttEntry.m_bound == eTTBound::EXACT ||
+                    (ttEntry.m_bound == eTTBound::LOWER && ttScore >= beta) ||
+                    (ttEntry.m_bound == eTTBound::UPPER && ttScore <= alpha)))
+            {
+                return ttScore;
+            }
+        }
+    }
+
+    MoveList moves;
+    GenerateLegalMoves(m_position, moves);
+
+    if (moves.IsEmpty()) return isInCheck ? -SCORE_MATE + ply : SCORE_DRAW;
+
+    PackedMove const pvMove       = m_isFollowingPV && ply < m_previousPVLength ? PackMove(m_previousPV[ply]) : NULL_PACKED_MOVE;
+    PackedMove const previousMove = ply > 0 ? m_playedMoves[ply - 1] : NULL_PACKED_MOVE;
+    ChessMovePicker  movePicker(m_position, moves, pvMove, ttMove, &m_orderTables, ply, previousMove);
+
+    int        bestScore = -SCORE_INFINITE;
+    PackedMove bestMove  = NULL_PACKED_MOVE;
+    PackedMove failedQuietMoves[MAX_MOVES];
+    int        failedQuietCount = 0;
+    sChessMove move;
+    sUndoState undoState;
+
+    for (int moveIndex = 0; movePicker.GetNextMove(move); ++moveIndex)
+    {
+        PackedMove const packedMove = PackMove(move);
+        bool const       isQuiet    = !move.IsCapture() && !move.IsPromotion();
+        int              score;
+
+        // Only the first child of a node on the previous PV is itself on it
+        if (moveIndex == 0) m_isFollowingPV = pvMove != NULL_PACKED_MOVE && packedMove == pvMove;
+
+        m_playedMoves[ply] = packedMove;
+        MakeMove(move, undoState);
+
+        if (moveIndex == 0)
+        {
+            score           = -SearchNode(-beta, -alpha, depth - 1, ply + 1);
+            m_isFollowingPV = false;
+        }
+        else
+        {
+            // Prove the move is no better than alpha with a null window; re-search only if that fails
+            score = -SearchNode(-alpha - 1, -alpha, depth - 1, ply + 1);
+
+            if (score > alpha && score < beta) score = -SearchNode(-beta, -alpha, depth - 1, ply + 1);
+        }
+
+        UnmakeMove(move, undoState);
+
+        if (IsStopped()) return 0;
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+
+            if (score > alpha)
+            {
+                alpha    = score;
+                bestMove = packedMove;
+                UpdatePrincipalVariation(move, ply);
+
+                if (alpha >= beta)
+                {
+                    ++m_failHighCount;
+
+                    if (moveIndex == 0) ++m_firstMoveFailHighCount;
+                    if (isQuiet) m_orderTables.UpdateOnCutoff(m_position, packedMove, ply, depth, previousMove, failedQuietMoves, failedQuietCount);
+
+                    break;
+                }
+            }
+        }
+
+        if (isQuiet) failedQuietMoves[failedQuietCount++] = packedMove;
+    }
+
+    if (m_transpositionTable != nullptr)
+    {
+        eTTBound const bound = bestScore >= beta ? eTTBound::LOWER : (bestScore > alphaOrigin ? eTTBound::EXACT : eTTBound::UPPER);
+
+        m_transpositionTable->Store(hash, bestMove, GetScoreToStore(bestScore, ply), depth, bound);
+    }
+
+    return bestScore;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Plays out captures and promotions until the position is quiet, so the static evaluation is
+/// never taken in the middle of an exchange. The side to move may stand pat on its evaluation unless
+/// it is in check, in which case every evasion is searched.
+int ChessSearch::SearchQuiescence(int       alpha,
+                                  int const beta,
+                                  int const ply)
+{
+    m_pvLength[ply] = 0;
+
+    if ((++m_nodeCount & (TIME_CHECK_INTERVAL - 1)) == 0) CheckHardTimeLimit();
+
+    if (ply > m_selectiveDepth) m_selectiveDepth = ply;
+    if (ply >= MAX_SEARCH_PLY - 1) return EvaluatePosition(m_position);
+
+    bool const isInCheck = m_position.IsInCheck(m_position.GetSideToMove());
+    int        bestScore = -SCORE_INFINITE;
+
+    if (!isInCheck)
+    {
+        bestScore = EvaluatePosition(m_position);
+
+        if (bestScore >= beta) return bestScore;
+        if (bestScore > alpha) alpha = bestScore;
+    }
+
+    MoveList moves;
+    GenerateLegalMoves(m_position, moves);
+
+    if (moves.IsEmpty()) return isInCheck ? -SCORE_MATE + ply : SCORE_DRAW;
+
+    int searchedCount = 0;
+
+    for (int moveIndex = 0; moveIndex < moves.GetSize(); ++moveIndex)
+    {
+        sChessMove const& move = moves[moveIndex];
+
+        if (!isInCheck && !move.IsCapture() && !move.IsPromotion()) continue;
+
+        moves[searchedCount++] = move;
+    }
+
+    moves.Resize(searchedCount);
+
+    ChessMovePicker movePicker(m_position, moves, NULL_PACKED_MOVE, NULL_PACKED_MOVE, nullptr, ply, NULL_PACKED_MOVE);
+    sChessMove      move;
+    sUndoState      undoState;
+
+    while (movePicker.GetNextMove(move))
+    {
+        MakeMove(move, undoState);
+        int const score = -SearchQuiescence(-beta, -alpha, ply + 1);
+        UnmakeMove(move, undoState);
+
+        if (IsStopped()) return 0;
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+
+            if (score > alpha)
+            {
+                alpha = score;
+                UpdatePrincipalVariation(move, ply);
+
+                if (alpha >= beta) break;
+            }
+        }
+    }
+
+    return bestScore;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessSearch::MakeMove(sChessMove const& move,
+                           sUndoState&       undoState)
+{
+    m_position.MakeMove(move, undoState);
+    m_hashHistory.Push(m_position.GetHash());
+
+    // The child probes its bucket only after its draw and check tests; start the load now
+    if (m_transpositionTable != nullptr) m_transpositionTable->Prefetch(m_position.GetHash());
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessSearch::UnmakeMove(sChessMove const& move,
+                             sUndoState const& undoState)
+{
+    m_hashHistory.Pop();
+    m_position.UnmakeMove(move, undoState);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessSearch::UpdatePrincipalVariation(sChessMove const& move,
+                                           int const         ply)
+{
+    int const childLength = m_pvLength[ply + 1];
+
+    m_pvTable[ply][0] = move;
+
+    for (int pvIndex = 0; pvIndex < childLength; ++pvIndex)
+    {
+        m_pvTable[ply][pvIndex + 1] = m_pvTable[ply + 1][pvIndex];
+    }
+
+    m_pvLength[ply] = childLength + 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessSearch::CheckHardTimeLimit()
+{
+    if (m_hasHardDeadline && std::chrono::steady_clock::now() >= m_hardDeadline) m_isHardTimeUp = true;
+}
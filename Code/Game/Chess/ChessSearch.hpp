@@ -0,0 +1,160 @@
+//----------------------------------------------------------------------------------------------------
+// ChessSearch.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "Game/Chess/ChessHashHistory.hpp"
+#include "Game/Chess/ChessMove.hpp"
+#include "Game/Chess/ChessMoveOrdering.hpp"
+#include "Game/Chess/ChessPosition.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class ChessTranspositionTable;
+
+//----------------------------------------------------------------------------------------------------
+int constexpr MAX_SEARCH_DEPTH = 64;
+int constexpr MAX_SEARCH_PLY   = 128;     // Main search plus quiescence, counted from the root
+
+int constexpr SCORE_INFINITE   = 32000;
+int constexpr SCORE_MATE       = 31000;   // Being mated at the root; mated n plies later scores -(SCORE_MATE - n)
+int constexpr SCORE_MATE_BOUND = SCORE_MATE - MAX_SEARCH_PLY;
+int constexpr SCORE_DRAW       = 0;
+
+static_assert(MAX_KILLER_PLY >= MAX_SEARCH_PLY, "Every search ply needs its killer moves");
+
+constexpr bool IsMateScore(int const score) { return score >= SCORE_MATE_BOUND || score <= -SCORE_MATE_BOUND; }
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The clock of the side to move. m_movesToGo is the number of moves until the next time
+/// control, or 0 when the remaining time has to last the rest of the game.
+struct sTimeControl
+{
+    double m_remainingSeconds = 0.0;
+    double m_incrementSeconds = 0.0;    // Added after every move
+    int    m_movesToGo        = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sSearchLimits
+{
+    int                      m_depth           = 5;          // Deepest iteration; plies searched before quiescence takes over
+    int                      m_startDepth      = 1;          // First iteration; Lazy SMP helpers start deeper to spread out
+    double                   m_softTimeSeconds = 0.0;        // No new iteration starts after this; 0 for no limit
+    double                   m_hardTimeSeconds = 0.0;        // The running iteration is abandoned at this; 0 for no limit
+    std::atomic<bool> const* m_stopFlag        = nullptr;    // Optional; the search unwinds as soon as it is set
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eSearchStopReason : uint8_t
+{
+    MAX_DEPTH,        // Every iteration up to sSearchLimits::m_depth completed
+    MATE_FOUND,       // A forced mate was proven within the searched depth
+    SOFT_TIME,        // The soft limit passed between iterations
+    STABLE_MOVE,      // The best move held for several iterations, so the soft limit was shortened
+    HARD_TIME,        // The hard limit cut an iteration short
+    STOP_FLAG         // The caller raised the stop flag
+};
+
+char const* GetSearchStopReasonName(eSearchStopReason stopReason);
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The outcome of the deepest completed iteration, with counters for the whole search.
+struct sSearchResult
+{
+    sChessMove              m_bestMove;                                                // m_fromSquare is INVALID_SQUARE when there is no legal move
+    int                     m_score                  = 0;                              // Centipawns from the side to move's point of view
+    int                     m_depth                  = 0;                              // Last completed iteration
+    int                     m_selectiveDepth         = 0;                              // Deepest ply reached, quiescence included
+    uint64_t                m_nodeCount              = 0;
+    uint64_t                m_ttProbeCount           = 0;                              // Transposition table lookups, 0 without a table
+    uint64_t                m_ttHitCount             = 0;
+    uint64_t                m_failHighCount          = 0;                              // Main search nodes that failed high
+    uint64_t                m_firstMoveFailHighCount = 0;                              // Those that failed high on the first move tried
+    double                  m_seconds                = 0.0;
+    eSearchStopReason       m_stopReason             = eSearchStopReason::MAX_DEPTH;
+    std::vector<sChessMove> m_principalVariation;
+
+    bool   HasBestMove() const { return m_bestMove.m_fromSquare != INVALID_SQUARE; }
+    bool   IsStopped() const { return m_stopReason == eSearchStopReason::STOP_FLAG; }
+    double GetNodesPerSecond() const { return m_seconds > 0.0 ? static_cast<double>(m_nodeCount) / m_seconds : 0.0; }
+    double GetTTHitRate() const { return m_ttProbeCount > 0 ? static_cast<double>(m_ttHitCount) / static_cast<double>(m_ttProbeCount) : 0.0; }
+    double GetFirstMoveFailHighRate() const { return m_failHighCount > 0 ? static_cast<double>(m_firstMoveFailHighCount) / static_cast<double>(m_failHighCount) : 0.0; }
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Splits the clock into a soft and a hard limit for one move. The soft limit is an even share
+/// of the time left over the moves to go plus most of the increment; the hard limit allows a few
+/// times that, but never more than a fraction of the clock, so one difficult move cannot lose on time.
+void AllocateMoveTime(sTimeControl const& timeControl, sSearchLimits& limits);
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Iterative deepening negamax alpha-beta search with a principal variation search window: the
+/// first move at each node is searched with the full window, the rest with a null window that is
+/// widened and re-searched only when a move beats alpha. Each iteration searches the previous
+/// iteration's principal variation first. Leaves are resolved by a capture-only quiescence search,
+/// checks are extended by one ply, and repetitions and the 50-move rule score as draws.
+///
+/// No iteration starts once the soft time limit has passed, and the soft limit shrinks while the
+/// best move stays the same from one iteration to the next. The hard limit abandons the running
+/// iteration, and the result is then the last completed one. Works on its own copy of the position
+/// and hash history, so Search may run on a worker thread while the caller keeps playing, and stops
+/// through the caller-owned flag in sSearchLimits.
+///
+/// With a transposition table, every main search node stores its score, bound and best move, and a
+/// stored result at least as deep cuts off null-window nodes. The table is not owned and may be
+/// shared with other searches; the caller bumps its generation before each search.
+///
+/// Moves are handed out by a ChessMovePicker: PV move, table move, winning captures, killers,
+/// countermove, quiet moves by history, losing captures. The killer, history and countermove tables
+/// belong to this search, so each Lazy SMP thread learns its own.
+class ChessSearch
+{
+public:
+    explicit ChessSearch(ChessTranspositionTable* transpositionTable = nullptr);
+
+    sSearchResult Search(ChessPosition const& position, ChessHashHistory const& hashHistory, sSearchLimits const& limits);
+
+private:
+    int  SearchNode(int alpha, int beta, int depth, int ply);
+    int  SearchQuiescence(int alpha, int beta, int ply);
+    void MakeMove(sChessMove const& move, sUndoState& undoState);
+    void UnmakeMove(sChessMove const& move, sUndoState const& undoState);
+    void UpdatePrincipalVariation(sChessMove const& move, int ply);
+    void CheckHardTimeLimit();
+    bool IsStopped() const { return m_isHardTimeUp || (m_stopFlag != nullptr && m_stopFlag->load(std::memory_order_relaxed)); }
+
+    ChessTranspositionTable* m_transpositionTable     = nullptr;    // Not owned; may be shared with other searches
+    ChessPosition            m_position;
+    ChessHashHistory         m_hashHistory;
+    uint64_t                 m_nodeCount              = 0;
+    uint64_t                 m_ttProbeCount           = 0;
+    uint64_t                 m_ttHitCount             = 0;
+    uint64_t                 m_failHighCount          = 0;
+    uint64_t                 m_firstMoveFailHighCount = 0;
+    int                      m_selectiveDepth         = 0;
+    std::atomic<bool> const* m_stopFlag               = nullptr;
+    bool                     m_isHardTimeUp           = false;
+
+    std::chrono::steady_clock::time_point m_hardDeadline;
+    bool                                  m_hasHardDeadline = false;
+
+    // Triangular PV table: row ply holds the best line found from that ply, m_pvLength[ply] moves long
+    sChessMove m_pvTable[MAX_SEARCH_PLY][MAX_SEARCH_PLY];
+    int        m_pvLength[MAX_SEARCH_PLY] = {};
+
+    // The previous iteration's principal variation, tried first by the next one while the search is
+    // still walking down that line
+    sChessMove m_previousPV[MAX_SEARCH_PLY];
+    int        m_previousPVLength = 0;
+    bool       m_isFollowingPV    = false;
+
+    ChessMoveOrderTables m_orderTables;
+    PackedMove           m_playedMoves[MAX_SEARCH_PLY] = {};    // The move played at each ply, for countermoves
+};
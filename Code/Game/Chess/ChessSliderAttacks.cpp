@@ -0,0 +1,593 @@
+//----------------------------------------------------------------------------------------------------
+// ChessSliderAttacks.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessSliderAttacks.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <memory>
+#include <vector>
+
+#include "Game/Chess/ChessAttacks.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#define CHESS_SLIDER_X64
+#include <immintrin.h>
+#if !defined(_MSC_VER)
+#include <cpuid.h>
+#endif
+#endif
+
+// GCC and Clang only emit BMI2 and AVX2 instructions inside functions marked for them, which keeps the
+// rest of the build runnable on CPUs without them. MSVC emits any intrinsic without a flag.
+#if defined(__GNUC__) || defined(__clang__)
+#define CHESS_TARGET(features) __attribute__((target(features)))
+#else
+#define CHESS_TARGET(features)
+#endif
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    typedef Bitboard (*SliderAttackFunction)(int square, Bitboard occupancy);
+
+    //------------------------------------------------------------------------------------------------
+    // Magic multipliers for the GetRelevantOccupancyMask masks, found offline by a seeded search over
+    // sparse random numbers (three SplitMix64 draws ANDed together). Two occupancies may share a slot
+    // only if their attacks are equal; BuildSliderEntries asserts that as it fills the table.
+    Bitboard constexpr BISHOP_MAGICS[NUM_SQUARES] = {
+        0x0020981100418604ULL, 0x464821240C0B4004ULL, 0x8008080153900010ULL, 0x0011040080000108ULL,
+        0x4401104080C25400ULL, 0x4048480230000000ULL, 0x0860484824100080ULL, 0x0000202208244008ULL,
+        0x0B404105080A0040ULL, 0x0000881104048202ULL, 0x5188040114010204ULL, 0x20282C05120908C0ULL,
+        0x0004011140040680ULL, 0x0084C09010090140ULL, 0x0840350842100480ULL, 0x0B00024052101001ULL,
+        0x6011202020321080ULL, 0x002008880830A080ULL, 0x7081000802040C10ULL, 0x0065204404008210ULL,
+        0x0004000210140418ULL, 0x240A0011008A1118ULL, 0x000C080084010904ULL, 0x0041002448480400ULL,
+        0x04C8094420200100ULL, 0x0618480422100100ULL, 0x041802500C040083ULL, 0x8482080104004008ULL,
+        0x0001010000104008ULL, 0x1031020085044108ULL, 0x8004010140411070ULL, 0x000040808100A800ULL,
+        0x0504104080090240ULL, 0x0604100800040100ULL, 0x0092109002280842ULL, 0x5020208020880201ULL,
+        0x8000920200040108ULL, 0x0040881200004103ULL, 0x0098014108040082ULL, 0x0001010024050412ULL,
+        0x9008040420940408ULL, 0x0202110403016000ULL, 0x0608802808010108ULL, 0x4203206011000810ULL,
+        0x0011080101007011ULL, 0x3509131019020080ULL, 0x00200480A0800200ULL, 0x0010010061001080ULL,
+        0x0002630420208820ULL, 0x4C04410090108100ULL, 0x8080008400C81004ULL, 0x008004A084142C10ULL,
+        0x0400022202440410ULL, 0x00000820040424C7ULL, 0x0104290808208001ULL, 0x00C901080085000AULL,
+        0x0202010402020200ULL, 0x0280A04048241000ULL, 0x0014200201008840ULL, 0x100104010C840404ULL,
+        0x40C0000040104102ULL, 0x0001002108B00920ULL, 0x1802090204040404ULL, 0x285002222C040012ULL,
+    };
+
+    Bitboard constexpr ROOK_MAGICS[NUM_SQUARES] = {
+        0x0080008040002010ULL, 0x0840200010004001ULL, 0x0080100080200008ULL, 0x0100090020061000ULL,
+        0x060010084C200201ULL, 0x8100040001000208ULL, 0x0200242800871200ULL, 0x0200002080410204ULL,
+        0x2230800020804002ULL, 0x0012802000400092ULL, 0x2000801000802000ULL, 0x4002002210400A00ULL,
+        0x2020800400800802ULL, 0x004A0002001C5008ULL, 0x40A1000100020004ULL, 0x9002000200408401ULL,
+        0x4000228000400080ULL, 0x0030184000200040ULL, 0x2020820010420020ULL, 0x4004090010002100ULL,
+        0x8002020008041021ULL, 0x2004008080020004ULL, 0x0040940011501208ULL, 0x0200020000810044ULL,
+        0x0128802080144001ULL, 0x8C00200440100040ULL, 0xA420008080100028ULL, 0x8010050100081021ULL,
+        0x0020080080040080ULL, 0x4102008080020400ULL, 0x0080040101000200ULL, 0x0020090200108444ULL,
+        0x1180112000C00046ULL, 0x0590002002400140ULL, 0x0700104101002000ULL, 0x0180082202001040ULL,
+        0x4204800800800400ULL, 0x0814008004802200ULL, 0x0002000802008104ULL, 0x910200490200009CULL,
+        0xC880804000308000ULL, 0x4090002000404002ULL, 0x2004150020010042ULL, 0x0001100100090020ULL,
+        0x9A40080005010011ULL, 0xC040200440080110ULL, 0x20100850020400A1ULL, 0x024100408C020011ULL,
+        0x4088210440800100ULL, 0x0820022440008B80ULL, 0x1901004010200100ULL, 0x08020C2100100100ULL,
+        0x0000100500080100ULL, 0x8001008400020900ULL, 0x0010010208500400ULL, 0x0001003840820100ULL,
+        0x0002800090204501ULL, 0x0000802100184001ULL, 0x1210102001044009ULL, 0x8032001004200842ULL,
+        0x0001000800040211ULL, 0x8001000804000A03ULL, 0x000030021688010CULL, 0x202004004420850AULL,
+    };
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Walks one ray from the square until it leaves the board or hits an occupied square.
+    Bitboard GetRayAttacks(int const      square,
+                           Bitboard const occupancy,
+                           int const      fileStep,
+                           int const      rankStep)
+    {
+        Bitboard attacks = 0;
+        int      file    = GetFile(square) + fileStep;
+        int      rank    = GetRank(square) + rankStep;
+
+        while (file >= 0 && file <= 7 && rank >= 0 && rank <= 7)
+        {
+            Bitboard const squareBit = GetSquareBit(GetSquare(file, rank));
+            attacks |= squareBit;
+
+            if (occupancy & squareBit) break;
+
+            file += fileStep;
+            rank += rankStep;
+        }
+
+        return attacks;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    Bitboard GetBishopAttacksLoop(int const      square,
+                                  Bitboard const occupancy)
+    {
+        return GetRayAttacks(square, occupancy, 1, 1) |
+            GetRayAttacks(square, occupancy, 1, -1) |
+            GetRayAttacks(square, occupancy, -1, -1) |
+            GetRayAttacks(square, occupancy, -1, 1);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    Bitboard GetRookAttacksLoop(int const      square,
+                                Bitboard const occupancy)
+    {
+        return GetRayAttacks(square, occupancy, 0, 1) |
+            GetRayAttacks(square, occupancy, 1, 0) |
+            GetRayAttacks(square, occupancy, 0, -1) |
+            GetRayAttacks(square, occupancy, -1, 0);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief
+    /// One square's slice of a lookup table. m_mask holds the squares whose occupancy can change the
+    /// attacks; the last square of each ray never can, so it is left out to keep the slice small.
+    /// m_magic and m_shift are only used by the MAGIC indexing.
+    struct sSliderEntry
+    {
+        Bitboard const* m_attacks = nullptr;
+        Bitboard        m_mask    = 0;
+        Bitboard        m_magic   = 0;
+        int             m_shift   = 0;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    struct sSliderTables
+    {
+        sSliderEntry                m_bishopEntries[NUM_SQUARES];
+        sSliderEntry                m_rookEntries[NUM_SQUARES];
+        std::unique_ptr<Bitboard[]> m_attacks;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    enum class eTableIndexing : uint8_t
+    {
+        MAGIC,
+        PEXT
+    };
+
+    //------------------------------------------------------------------------------------------------
+    Bitboard GetRelevantOccupancyMask(int const                  square,
+                                      SliderAttackFunction const getAttacks)
+    {
+        Bitboard const ownRank = RANK_1_BITBOARD << (8 * GetRank(square));
+        Bitboard const ownFile = FILE_A_BITBOARD << GetFile(square);
+        Bitboard const edges   = ((RANK_1_BITBOARD | RANK_8_BITBOARD) & ~ownRank) | ((FILE_A_BITBOARD | FILE_H_BITBOARD) & ~ownFile);
+
+        return getAttacks(square, 0) & ~edges;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void BuildSliderEntries(sSliderEntry* const        entries,
+                            SliderAttackFunction const getAttacks,
+                            Bitboard const*            magics,
+                            eTableIndexing const       indexing,
+                            Bitboard*&                 nextSlot)
+    {
+        std::vector<Bitboard> occupancies;
+        std::vector<Bitboard> attacks;
+
+        for (int square = 0; square < NUM_SQUARES; ++square)
+        {
+            sSliderEntry& entry = entries[square];
+            entry.m_mask        = GetRelevantOccupancyMask(square, getAttacks);
+            entry.m_shift       = 64 - PopCount(entry.m_mask);
+            entry.m_attacks     = nextSlot;
+
+            occupancies.clear();
+            attacks.clear();
+
+            // Carry-rippler walk over every subset of the mask, in increasing order, which is also the
+            // order PEXT numbers them in
+            Bitboard subset = 0;
+            do
+            {
+                occupancies.push_back(subset);
+                attacks.push_back(getAttacks(square, subset));
+                subset = (subset - entry.m_mask) & entry.m_mask;
+            }
+            while (subset != 0);
+
+            if (indexing == eTableIndexing::PEXT)
+            {
+                for (size_t subsetIndex = 0; subsetIndex < attacks.size(); ++subsetIndex)
+                {
+                    nextSlot[subsetIndex] = attacks[subsetIndex];
+                }
+            }
+            else
+            {
+                entry.m_magic = magics[square];
+
+                for (size_t subsetIndex = 0; subsetIndex < attacks.size(); ++subsetIndex)
+                {
+                    Bitboard& slot = nextSlot[(occupancies[subsetIndex] * entry.m_magic) >> entry.m_shift];
+
+                    // Slider attacks are never empty, so 0 marks a slot nothing has claimed yet
+                    assert(slot == 0 || slot == attacks[subsetIndex]);
+                    slot = attacks[subsetIndex];
+                }
+            }
+
+            nextSlot += occupancies.size();
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Builds the bishop and rook tables in one allocation: 5,248 bishop and 102,400 rook slots.
+    sSliderTables BuildSliderTables(eTableIndexing const indexing)
+    {
+        size_t slotCount = 0;
+
+        for (int square = 0; square < NUM_SQUARES; ++square)
+        {
+            slotCount += size_t(1) << PopCount(GetRelevantOccupancyMask(square, &GetBishopAttacksLoop));
+            slotCount += size_t(1) << PopCount(GetRelevantOccupancyMask(square, &GetRookAttacksLoop));
+        }
+
+        sSliderTables tables;
+        tables.m_attacks   = std::make_unique<Bitboard[]>(slotCount);
+        Bitboard* nextSlot = tables.m_attacks.get();
+
+        BuildSliderEntries(tables.m_bishopEntries, &GetBishopAttacksLoop, BISHOP_MAGICS, indexing, nextSlot);
+        BuildSliderEntries(tables.m_rookEntries, &GetRookAttacksLoop, ROOK_MAGICS, indexing, nextSlot);
+
+        return tables;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sSliderTables const& GetMagicTables()
+    {
+        static sSliderTables const s_magicTables = BuildSliderTables(eTableIndexing::MAGIC);
+        return s_magicTables;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sSliderTables const& GetPextTables()
+    {
+        static sSliderTables const s_pextTables = BuildSliderTables(eTableIndexing::PEXT);
+        return s_pextTables;
+    }
+
+    // Set by SetSliderBackend before the attack functions that read them are published
+    sSliderTables const* s_magicTables = nullptr;
+    sSliderTables const* s_pextTables  = nullptr;
+
+    //------------------------------------------------------------------------------------------------
+    Bitboard GetBishopAttacksMagic(int const      square,
+                                   Bitboard const occupancy)
+    {
+        sSliderEntry const& entry = s_magicTables->m_bishopEntries[square];
+        return entry.m_attacks[((occupancy & entry.m_mask) * entry.m_magic) >> entry.m_shift];
+    }
+
+    //------------------------------------------------------------------------------------------------
+    Bitboard GetRookAttacksMagic(int const      square,
+                                 Bitboard const occupancy)
+    {
+        sSliderEntry const& entry = s_magicTables->m_rookEntries[square];
+        return entry.m_attacks[((occupancy & entry.m_mask) * entry.m_magic) >> entry.m_shift];
+    }
+
+#if defined(CHESS_SLIDER_X64)
+    //------------------------------------------------------------------------------------------------
+    CHESS_TARGET("bmi2")
+    Bitboard GetBishopAttacksPext(int const      square,
+                                  Bitboard const occupancy)
+    {
+        sSliderEntry const& entry = s_pextTables->m_bishopEntries[square];
+        return entry.m_attacks[_pext_u64(occupancy, entry.m_mask)];
+    }
+
+    //------------------------------------------------------------------------------------------------
+    CHESS_TARGET("bmi2")
+    Bitboard GetRookAttacksPext(int const      square,
+                                Bitboard const occupancy)
+    {
+        sSliderEntry const& entry = s_pextTables->m_rookEntries[square];
+        return entry.m_attacks[_pext_u64(occupancy, entry.m_mask)];
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief
+    /// Four ray directions of one slider, as two lanes shifted towards higher squares and two towards
+    /// lower ones. Each mask clears the file a shift would wrap onto.
+    struct sKoggeStoneDirections
+    {
+        int64_t  m_upShifts[2];
+        Bitboard m_upMasks[2];
+        int64_t  m_downShifts[2];
+        Bitboard m_downMasks[2];
+    };
+
+    sKoggeStoneDirections constexpr BISHOP_DIRECTIONS = {{9, 7}, {~FILE_A_BITBOARD, ~FILE_H_BITBOARD}, {9, 7}, {~FILE_H_BITBOARD, ~FILE_A_BITBOARD}};
+    sKoggeStoneDirections constexpr ROOK_DIRECTIONS   = {{8, 1}, {~0ULL, ~FILE_A_BITBOARD}, {8, 1}, {~0ULL, ~FILE_H_BITBOARD}};
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief
+    /// Occluded Kogge-Stone fill: spreads the slider through empty squares in 1, 2 and 4 step jumps,
+    /// then shifts once more so the first blocker in each direction is included.
+    CHESS_TARGET("avx2")
+    Bitboard GetSliderAttacksKoggeStone(int const                    square,
+                                        Bitboard const               occupancy,
+                                        sKoggeStoneDirections const& directions)
+    {
+        __m128i const squareBit = _mm_set1_epi64x(static_cast<long long>(GetSquareBit(square)));
+        __m128i const empty     = _mm_set1_epi64x(static_cast<long long>(~occupancy));
+
+        __m128i const upShift   = _mm_loadu_si128(reinterpret_cast<__m128i const*>(directions.m_upShifts));
+        __m128i const upMask    = _mm_loadu_si128(reinterpret_cast<__m128i const*>(directions.m_upMasks));
+        __m128i       shift     = upShift;
+        __m128i       generator = squareBit;
+        __m128i       propagate = _mm_and_si128(empty, upMask);
+
+        generator = _mm_or_si128(generator, _mm_and_si128(propagate, _mm_sllv_epi64(generator, shift)));
+        propagate = _mm_and_si128(propagate, _mm_sllv_epi64(propagate, shift));
+        shift     = _mm_add_epi64(shift, shift);
+        generator = _mm_or_si128(generator, _mm_and_si128(propagate, _mm_sllv_epi64(generator, shift)));
+        propagate = _mm_and_si128(propagate, _mm_sllv_epi64(propagate, shift));
+        shift     = _mm_add_epi64(shift, shift);
+        generator = _mm_or_si128(generator, _mm_and_si128(propagate, _mm_sllv_epi64(generator, shift)));
+
+        __m128i const upAttacks = _mm_and_si128(upMask, _mm_sllv_epi64(generator, upShift));
+
+        __m128i const downShift = _mm_loadu_si128(reinterpret_cast<__m128i const*>(directions.m_downShifts));
+        __m128i const downMask  = _mm_loadu_si128(reinterpret_cast<__m128i const*>(directions.m_downMasks));
+        shift                   = downShift;
+        generator               = squareBit;
+        propagate               = _mm_and_si128(empty, downMask);
+
+        generator = _mm_or_si128(generator, _mm_and_si128(propagate, _mm_srlv_epi64(generator, shift)));
+        propagate = _mm_and_si128(propagate, _mm_srlv_epi64(propagate, shift));
+        shift     = _mm_add_epi64(shift, shift);
+        generator = _mm_or_si128(generator, _mm_and_si128(propagate, _mm_srlv_epi64(generator, shift)));
+        propagate = _mm_and_si128(propagate, _mm_srlv_epi64(propagate, shift));
+        shift     = _mm_add_epi64(shift, shift);
+        generator = _mm_or_si128(generator, _mm_and_si128(propagate, _mm_srlv_epi64(generator, shift)));
+
+        __m128i const downAttacks = _mm_and_si128(downMask, _mm_srlv_epi64(generator, downShift));
+        __m128i const attacks     = _mm_or_si128(upAttacks, downAttacks);
+
+        return static_cast<Bitboard>(_mm_cvtsi128_si64(_mm_or_si128(attacks, _mm_unpackhi_epi64(attacks, attacks))));
+    }
+
+    //------------------------------------------------------------------------------------------------
+    Bitboard GetBishopAttacksKoggeStone(int const      square,
+                                        Bitboard const occupancy)
+    {
+        return GetSliderAttacksKoggeStone(square, occupancy, BISHOP_DIRECTIONS);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    Bitboard GetRookAttacksKoggeStone(int const      square,
+                                      Bitboard const occupancy)
+    {
+        return GetSliderAttacksKoggeStone(square, occupancy, ROOK_DIRECTIONS);
+    }
+#endif
+
+    //------------------------------------------------------------------------------------------------
+    struct sCpuFeatures
+    {
+        bool m_hasBmi2     = false;
+        bool m_hasAvx2     = false;
+        bool m_hasSlowPext = false;
+    };
+
+#if defined(CHESS_SLIDER_X64)
+    //------------------------------------------------------------------------------------------------
+    /// @brief Fills registers with EAX, EBX, ECX and EDX for the CPUID leaf.
+    void GetCpuid(unsigned int const leaf,
+                  unsigned int const subleaf,
+                  unsigned int       (&registers)[4])
+    {
+#if defined(_MSC_VER)
+        int values[4] = {};
+        __cpuidex(values, static_cast<int>(leaf), static_cast<int>(subleaf));
+        for (int registerIndex = 0; registerIndex < 4; ++registerIndex) registers[registerIndex] = static_cast<unsigned int>(values[registerIndex]);
+#else
+        __cpuid_count(leaf, subleaf, registers[0], registers[1], registers[2], registers[3]);
+#endif
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Reads XCR0, the register state the OS saves on context switches. Needs OSXSAVE.
+    uint64_t GetEnabledRegisterState()
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        unsigned int lowBits  = 0;
+        unsigned int highBits = 0;
+        __asm__ volatile("xgetbv" : "=a"(lowBits), "=d"(highBits) : "c"(0));
+        return (static_cast<uint64_t>(highBits) << 32) | lowBits;
+#endif
+    }
+#endif
+
+    //------------------------------------------------------------------------------------------------
+    sCpuFeatures DetectCpuFeatures()
+    {
+        sCpuFeatures features;
+
+#if defined(CHESS_SLIDER_X64)
+        unsigned int registers[4] = {};
+
+        GetCpuid(0, 0, registers);
+        unsigned int const maxLeaf = registers[0];
+        bool const         isAmd   = registers[1] == 0x68747541 && registers[3] == 0x69746E65 && registers[2] == 0x444D4163; // "AuthenticAMD"
+
+        GetCpuid(1, 0, registers);
+        unsigned int const baseFamily      = (registers[0] >> 8) & 0xF;
+        unsigned int const family          = baseFamily == 0xF ? baseFamily + ((registers[0] >> 20) & 0xFF) : baseFamily;
+        bool const         hasOsXsave      = (registers[2] & (1u << 27)) != 0;
+        bool const         hasAvx          = (registers[2] & (1u << 28)) != 0;
+        bool const         isAvxStateSaved = hasOsXsave && hasAvx && (GetEnabledRegisterState() & 0x6) == 0x6;
+
+        if (maxLeaf >= 7)
+        {
+            GetCpuid(7, 0, registers);
+            features.m_hasBmi2 = (registers[1] & (1u << 8)) != 0;
+            features.m_hasAvx2 = isAvxStateSaved && (registers[1] & (1u << 5)) != 0;
+        }
+
+        // AMD before Zen 3 (family 19h) runs PEXT in microcode, many times slower than a multiply
+        features.m_hasSlowPext = isAmd && family < 0x19;
+#endif
+
+        return features;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sCpuFeatures const& GetCpuFeatures()
+    {
+        static sCpuFeatures const s_cpuFeatures = DetectCpuFeatures();
+        return s_cpuFeatures;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void EnsureSliderBackendSelected();
+
+    //------------------------------------------------------------------------------------------------
+    Bitboard GetBishopAttacksFirstCall(int const      square,
+                                       Bitboard const occupancy)
+    {
+        EnsureSliderBackendSelected();
+        return GetBishopAttacks(square, occupancy);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    Bitboard GetRookAttacksFirstCall(int const      square,
+                                     Bitboard const occupancy)
+    {
+        EnsureSliderBackendSelected();
+        return GetRookAttacks(square, occupancy);
+    }
+
+    // Constant-initialised, so attacks requested during another file's static initialisation still work
+    std::atomic<SliderAttackFunction> s_bishopAttackFunction = {&GetBishopAttacksFirstCall};
+    std::atomic<SliderAttackFunction> s_rookAttackFunction   = {&GetRookAttacksFirstCall};
+    std::atomic<eSliderBackend>       s_sliderBackend        = {eSliderBackend::LOOP};
+    std::atomic<bool>                 s_isBackendSelected    = {false};
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Runs the CPUID-based selection once, unless SetSliderBackend was already called.
+    void EnsureSliderBackendSelected()
+    {
+        if (s_isBackendSelected.load(std::memory_order_acquire)) return;
+
+        static bool const s_isDetectedBackendSet = SetSliderBackend(DetectBestSliderBackend());
+        (void)s_isDetectedBackendSet;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+Bitboard GetBishopAttacks(int const      square,
+                          Bitboard const occupancy)
+{
+    return s_bishopAttackFunction.load(std::memory_order_acquire)(square, occupancy);
+}
+
+//----------------------------------------------------------------------------------------------------
+Bitboard GetRookAttacks(int const      square,
+                        Bitboard const occupancy)
+{
+    return s_rookAttackFunction.load(std::memory_order_acquire)(square, occupancy);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief PEXT where it is fast, fancy magics everywhere else.
+eSliderBackend DetectBestSliderBackend()
+{
+    sCpuFeatures const& features = GetCpuFeatures();
+
+    if (features.m_hasBmi2 && !features.m_hasSlowPext) return eSliderBackend::PEXT;
+
+    return eSliderBackend::MAGIC;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool IsSliderBackendSupported(eSliderBackend const backend)
+{
+    switch (backend)
+    {
+    case eSliderBackend::LOOP:
+    case eSliderBackend::MAGIC:
+        return true;
+
+#if defined(CHESS_SLIDER_X64)
+    case eSliderBackend::PEXT:
+        return GetCpuFeatures().m_hasBmi2;
+
+    case eSliderBackend::KOGGE_STONE:
+        return GetCpuFeatures().m_hasAvx2;
+#endif
+
+    default:
+        return false;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Builds the backend's tables on first use, then publishes its attack functions.
+bool SetSliderBackend(eSliderBackend const backend)
+{
+    if (!IsSliderBackendSupported(backend)) return false;
+
+    SliderAttackFunction getBishopAttacks = &GetBishopAttacksLoop;
+    SliderAttackFunction getRookAttacks   = &GetRookAttacksLoop;
+
+    switch (backend)
+    {
+    case eSliderBackend::MAGIC:
+        s_magicTables    = &GetMagicTables();
+        getBishopAttacks = &GetBishopAttacksMagic;
+        getRookAttacks   = &GetRookAttacksMagic;
+        break;
+
+#if defined(CHESS_SLIDER_X64)
+    case eSliderBackend::PEXT:
+        s_pextTables     = &GetPextTables();
+        getBishopAttacks = &GetBishopAttacksPext;
+        getRookAttacks   = &GetRookAttacksPext;
+        break;
+
+    case eSliderBackend::KOGGE_STONE:
+        getBishopAttacks = &GetBishopAttacksKoggeStone;
+        getRookAttacks   = &GetRookAttacksKoggeStone;
+        break;
+#endif
+
+    default:
+        break;
+    }
+
+    s_bishopAttackFunction.store(getBishopAttacks, std::memory_order_release);
+    s_rookAttackFunction.store(getRookAttacks, std::memory_order_release);
+    s_sliderBackend.store(backend, std::memory_order_relaxed);
+    s_isBackendSelected.store(true, std::memory_order_release);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+eSliderBackend GetSliderBackend()
+{
+    EnsureSliderBackendSelected();
+    return s_sliderBackend.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* GetSliderBackendName(eSliderBackend const backend)
+{
+    switch (backend)
+    {
+    case eSliderBackend::LOOP:        return "Loop";
+    case eSliderBackend::MAGIC:       return "Magic";
+    case eSliderBackend::PEXT:        return "PEXT";
+    case eSliderBackend::KOGGE_STONE: return "Kogge-Stone";
+    default:                          return "Unknown";
+    }
+}
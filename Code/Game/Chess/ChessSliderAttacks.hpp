@@ -0,0 +1,35 @@
+//----------------------------------------------------------------------------------------------------
+// ChessSliderAttacks.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/Chess/ChessCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Implementations behind GetBishopAttacks and GetRookAttacks. All of them return identical sets.
+/// LOOP walks each ray square by square and is kept as the reference. MAGIC is fancy magic
+/// bitboards, the portable default. PEXT indexes the same kind of table with the BMI2 instruction.
+/// KOGGE_STONE computes the attacks with a parallel-prefix fill, two directions per AVX2 register,
+/// and needs no tables.
+enum class eSliderBackend : uint8_t
+{
+    LOOP,
+    MAGIC,
+    PEXT,
+    KOGGE_STONE
+};
+
+//----------------------------------------------------------------------------------------------------
+int constexpr NUM_SLIDER_BACKENDS = 4;
+
+//----------------------------------------------------------------------------------------------------
+// The backend is picked by DetectBestSliderBackend the first time a slider attack is requested.
+// SetSliderBackend overrides that choice and returns false, keeping the current backend, if the CPU
+// lacks the instructions it needs. Switch backends only while no other thread is generating attacks.
+eSliderBackend DetectBestSliderBackend();
+bool           IsSliderBackendSupported(eSliderBackend backend);
+bool           SetSliderBackend(eSliderBackend backend);
+eSliderBackend GetSliderBackend();
+char const*    GetSliderBackendName(eSliderBackend backend);
@@ -0,0 +1,59 @@
+//----------------------------------------------------------------------------------------------------
+// ChessTestPositions.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <string>
+
+//----------------------------------------------------------------------------------------------------
+int constexpr MAX_REFERENCE_PERFT_DEPTH = 6;
+
+//----------------------------------------------------------------------------------------------------
+struct sChessTestPosition
+{
+    char const* m_name       = nullptr;
+    char const* m_fen        = nullptr;
+    int         m_suiteDepth = 0;                                   // Depth the perft suite runs by default
+    uint64_t    m_perftNodeCounts[MAX_REFERENCE_PERFT_DEPTH] = {};  // Known leaf counts for depth 1..6
+
+    uint64_t GetExpectedNodeCount(int const depth) const { return depth >= 1 && depth <= MAX_REFERENCE_PERFT_DEPTH ? m_perftNodeCounts[depth - 1] : 0; }
+};
+
+//----------------------------------------------------------------------------------------------------
+// Standard move generator test positions and their perft node counts (chessprogramming.org "Perft Results").
+sChessTestPosition constexpr CHESS_TEST_POSITIONS[] =
+{
+    {"Initial", "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, {20, 400, 8902, 197281, 4865609, 119060324}},
+    {"Kiwipete", "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, {48, 2039, 97862, 4085603, 193690690, 8031647685}},
+    {"Position3", "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 5, {14, 191, 2812, 43238, 674624, 11030083}},
+    {"Position4", "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 4, {6, 264, 9467, 422333, 15833292, 706045033}},
+    {"Position5", "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 4, {44, 1486, 62379, 2103487, 89941194, 3048196529}},
+    {"Position6", "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10", 4, {46, 2079, 89890, 3894594, 164075551, 6923051137}},
+};
+
+int constexpr NUM_CHESS_TEST_POSITIONS = sizeof(CHESS_TEST_POSITIONS) / sizeof(CHESS_TEST_POSITIONS[0]);
+
+//----------------------------------------------------------------------------------------------------
+/// @return The test position with the given name (case-insensitive), or nullptr if there is none.
+inline sChessTestPosition const* FindChessTestPosition(std::string const& name)
+{
+    for (sChessTestPosition const& testPosition : CHESS_TEST_POSITIONS)
+    {
+        std::string const testName = testPosition.m_name;
+
+        if (testName.size() != name.size()) continue;
+
+        bool isMatch = true;
+
+        for (size_t charIndex = 0; charIndex < name.size() && isMatch; ++charIndex)
+        {
+            isMatch = (testName[charIndex] | 0x20) == (name[charIndex] | 0x20);
+        }
+
+        if (isMatch) return &testPosition;
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,119 @@
+//----------------------------------------------------------------------------------------------------
+// ChessThreadPool.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessThreadPool.hpp"
+
+//----------------------------------------------------------------------------------------------------
+/// @param threadCount Total threads including the caller; 0 or less uses every hardware thread.
+ChessThreadPool::ChessThreadPool(int const threadCount)
+{
+    int const totalThreadCount = threadCount > 0 ? threadCount : GetHardwareThreadCount();
+
+    for (int workerIndex = 1; workerIndex < totalThreadCount; ++workerIndex)
+    {
+        m_workers.emplace_back(&ChessThreadPool::WorkerMain, this);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+ChessThreadPool::~ChessThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isShuttingDown = true;
+    }
+
+    m_wakeCondition.notify_all();
+
+    for (std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Calls task(taskIndex) once for every index in [0, taskCount) across all threads and returns
+/// when every task has finished.
+void ChessThreadPool::ParallelFor(int const                taskCount,
+                                  ChessTaskFunction const& task)
+{
+    if (m_workers.empty() || taskCount <= 1)
+    {
+        for (int taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+        {
+            task(taskIndex);
+        }
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task              = &task;
+        m_taskCount         = taskCount;
+        m_activeWorkerCount = static_cast<int>(m_workers.size());
+        m_nextTaskIndex.store(0);
+        ++m_jobGeneration;
+    }
+
+    m_wakeCondition.notify_all();
+    RunTasks(task, taskCount);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this] { return m_activeWorkerCount == 0; });
+    m_task = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ChessThreadPool::GetHardwareThreadCount()
+{
+    unsigned int const hardwareThreadCount = std::thread::hardware_concurrency();
+
+    return hardwareThreadCount > 0 ? static_cast<int>(hardwareThreadCount) : 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessThreadPool::WorkerMain()
+{
+    uint64_t seenJobGeneration = 0;
+
+    for (;;)
+    {
+        ChessTaskFunction const* task      = nullptr;
+        int                      taskCount = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [this, seenJobGeneration] { return m_isShuttingDown || m_jobGeneration != seenJobGeneration; });
+
+            if (m_isShuttingDown) return;
+
+            seenJobGeneration = m_jobGeneration;
+            task              = m_task;
+            taskCount         = m_taskCount;
+        }
+
+        RunTasks(*task, taskCount);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (--m_activeWorkerCount == 0)
+            {
+                m_doneCondition.notify_all();
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessThreadPool::RunTasks(ChessTaskFunction const& task,
+                               int const                taskCount)
+{
+    for (int taskIndex = m_nextTaskIndex.fetch_add(1); taskIndex < taskCount; taskIndex = m_nextTaskIndex.fetch_add(1))
+    {
+        task(taskIndex);
+    }
+}
@@ -0,0 +1,52 @@
+//----------------------------------------------------------------------------------------------------
+// ChessThreadPool.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+typedef std::function<void(int taskIndex)> ChessTaskFunction;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Fixed set of worker threads that run parallel-for jobs for perft and search. The calling thread
+/// takes part in every job, so a pool of N threads owns N - 1 workers. Tasks are handed out through
+/// an atomic counter; which thread runs a task is not deterministic, so callers write each task's
+/// result into its own slot and aggregate afterwards.
+class ChessThreadPool
+{
+public:
+    explicit ChessThreadPool(int threadCount);
+    ~ChessThreadPool();
+
+    ChessThreadPool(ChessThreadPool const& copy)            = delete;
+    ChessThreadPool& operator=(ChessThreadPool const& copy) = delete;
+
+    void ParallelFor(int taskCount, ChessTaskFunction const& task);
+    int  GetThreadCount() const { return static_cast<int>(m_workers.size()) + 1; }
+
+    static int GetHardwareThreadCount();
+
+private:
+    void WorkerMain();
+    void RunTasks(ChessTaskFunction const& task, int taskCount);
+
+    std::vector<std::thread> m_workers;
+    std::mutex               m_mutex;
+    std::condition_variable  m_wakeCondition;
+    std::condition_variable  m_doneCondition;
+    ChessTaskFunction const* m_task              = nullptr;
+    int                      m_taskCount         = 0;
+    std::atomic<int>         m_nextTaskIndex     = {0};
+    int                      m_activeWorkerCount = 0;
+    uint64_t                 m_jobGeneration     = 0;
+    bool                     m_isShuttingDown    = false;
+};
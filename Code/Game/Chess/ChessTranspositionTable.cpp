@@ -0,0 +1,303 @@
+//----------------------------------------------------------------------------------------------------
+// ChessTranspositionTable.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessTranspositionTable.hpp"
+
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#elif defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    // Entry data, low bits first: move (16), score + SCORE_OFFSET (16), depth (8), bound (2),
+    // generation (6). An all-zero entry has bound NONE and never counts as a hit.
+    int constexpr     SCORE_SHIFT      = 16;
+    int constexpr     DEPTH_SHIFT      = 32;
+    int constexpr     BOUND_SHIFT      = 40;
+    int constexpr     GENERATION_SHIFT = 42;
+    int constexpr     SCORE_OFFSET     = 32768;
+    uint8_t constexpr GENERATION_MASK  = 63;
+    size_t constexpr  LARGE_PAGE_SIZE  = 2 * 1024 * 1024;
+    size_t constexpr  HASH_FULL_SAMPLE = 250;    // Buckets sampled by GetHashFullPermille; 1000 entries
+
+    //------------------------------------------------------------------------------------------------
+    struct sEntryData
+    {
+        PackedMove m_move       = NULL_PACKED_MOVE;
+        int        m_score      = 0;
+        int        m_depth      = 0;
+        eTTBound   m_bound      = eTTBound::NONE;
+        uint8_t    m_generation = 0;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    uint64_t PackEntryData(sEntryData const& entryData)
+    {
+        return static_cast<uint64_t>(entryData.m_move) |
+            static_cast<uint64_t>(entryData.m_score + SCORE_OFFSET) << SCORE_SHIFT |
+            static_cast<uint64_t>(entryData.m_depth & 0xFF) << DEPTH_SHIFT |
+            static_cast<uint64_t>(entryData.m_bound) << BOUND_SHIFT |
+            static_cast<uint64_t>(entryData.m_generation & GENERATION_MASK) << GENERATION_SHIFT;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sEntryData UnpackEntryData(uint64_t const data)
+    {
+        sEntryData entryData;
+        entryData.m_move       = static_cast<PackedMove>(data & 0xFFFF);
+        entryData.m_score      = static_cast<int>((data >> SCORE_SHIFT) & 0xFFFF) - SCORE_OFFSET;
+        entryData.m_depth      = static_cast<int>((data >> DEPTH_SHIFT) & 0xFF);
+        entryData.m_bound      = static_cast<eTTBound>((data >> BOUND_SHIFT) & 3);
+        entryData.m_generation = static_cast<uint8_t>((data >> GENERATION_SHIFT) & GENERATION_MASK);
+        return entryData;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief How many searches ago the entry was written, wrapping with the 6-bit generation.
+    int GetEntryAge(sEntryData const& entryData,
+                    uint8_t const     generation)
+    {
+        return (generation - entryData.m_generation) & GENERATION_MASK;
+    }
+
+#if defined(_WIN32)
+    //------------------------------------------------------------------------------------------------
+    /// @brief Large pages need SeLockMemoryPrivilege in the process token. Most accounts do not have
+    /// it, in which case the allocation below fails and the caller falls back to normal pages.
+    void* AllocateLargePages(size_t& sizeInBytes)
+    {
+        size_t const largePageSize = GetLargePageMinimum();
+
+        if (largePageSize == 0) return nullptr;
+
+        HANDLE token = nullptr;
+
+        if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &token)) return nullptr;
+
+        TOKEN_PRIVILEGES privileges         = {};
+        privileges.PrivilegeCount           = 1;
+        privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+        void* memory = nullptr;
+
+        if (LookupPrivilegeValueA(nullptr, "SeLockMemoryPrivilege", &privileges.Privileges[0].Luid) &&
+            AdjustTokenPrivileges(token, FALSE, &privileges, 0, nullptr, nullptr) &&
+            GetLastError() == ERROR_SUCCESS)
+        {
+            size_t const roundedSize = (sizeInBytes + largePageSize - 1) / largePageSize * largePageSize;
+
+            memory = VirtualAlloc(nullptr, roundedSize, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+
+            if (memory != nullptr) sizeInBytes = roundedSize;
+        }
+
+        CloseHandle(token);
+        return memory;
+    }
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Allocates the largest power-of-two bucket count that fits in the budget (at least one bucket).
+ChessTranspositionTable::ChessTranspositionTable(size_t const sizeInMegabytes)
+{
+    size_t const budgetBucketCount = sizeInMegabytes * 1024 * 1024 / sizeof(sBucket);
+
+    m_bucketCount = 1;
+
+    while (m_bucketCount * 2 <= budgetBucketCount)
+    {
+        m_bucketCount *= 2;
+    }
+
+    m_allocatedBytes = m_bucketCount * sizeof(sBucket);
+
+    void* memory = nullptr;
+
+#if defined(_WIN32)
+    memory              = AllocateLargePages(m_allocatedBytes);
+    m_isUsingLargePages = memory != nullptr;
+
+    // VirtualAlloc returns page-aligned memory, which covers the cache-line alignment of sBucket
+    if (memory == nullptr) memory = VirtualAlloc(nullptr, m_allocatedBytes, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+#else
+    // Aligning to the huge page size lets the kernel back the table with transparent huge pages
+    size_t const alignment = m_allocatedBytes >= LARGE_PAGE_SIZE ? LARGE_PAGE_SIZE : alignof(sBucket);
+
+    m_allocatedBytes = (m_allocatedBytes + alignment - 1) / alignment * alignment;
+    memory           = std::aligned_alloc(alignment, m_allocatedBytes);
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    m_isUsingLargePages = memory != nullptr && alignment == LARGE_PAGE_SIZE && madvise(memory, m_allocatedBytes, MADV_HUGEPAGE) == 0;
+#endif
+#endif
+
+    if (memory == nullptr) throw std::bad_alloc();
+
+    m_buckets = static_cast<sBucket*>(memory);
+
+    for (size_t bucketIndex = 0; bucketIndex < m_bucketCount; ++bucketIndex)
+    {
+        new (&m_buckets[bucketIndex]) sBucket();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+ChessTranspositionTable::~ChessTranspositionTable()
+{
+    // sBucket holds only atomics of integers, which need no destruction
+#if defined(_WIN32)
+    VirtualFree(m_buckets, 0, MEM_RELEASE);
+#else
+    std::free(m_buckets);
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ChessTranspositionTable::Probe(uint64_t const  hash,
+                                    sTTProbeResult& result) const
+{
+    sBucket const& bucket = GetBucket(hash);
+
+    for (sEntry const& entry : bucket.m_entries)
+    {
+        uint64_t const data     = entry.m_data.load(std::memory_order_relaxed);
+        uint64_t const checkKey = entry.m_checkKey.load(std::memory_order_relaxed);
+
+        if ((checkKey ^ data) != hash) continue;
+
+        sEntryData const entryData = UnpackEntryData(data);
+
+        if (entryData.m_bound == eTTBound::NONE) continue;
+
+        result.m_move  = entryData.m_move;
+        result.m_score = entryData.m_score;
+        result.m_depth = entryData.m_depth;
+        result.m_bound = entryData.m_bound;
+        return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Writes over the slot already holding this position, unless that would swap a deeper
+/// current result for a shallower one. A new position takes the weakest depth-preferred slot, weighing
+/// age against depth, if it is at least as deep or that slot is stale; otherwise it takes the
+/// always-replace slot.
+void ChessTranspositionTable::Store(uint64_t const   hash,
+                                    PackedMove const move,
+                                    int const        score,
+                                    int const        depth,
+                                    eTTBound const   bound)
+{
+    int constexpr ALWAYS_REPLACE_SLOT = BUCKET_SIZE - 1;
+
+    sBucket&   bucket = GetBucket(hash);
+    sEntryData newEntryData;
+    newEntryData.m_move       = move;
+    newEntryData.m_score      = score;
+    newEntryData.m_depth      = depth < 0 ? 0 : (depth > 255 ? 255 : depth);
+    newEntryData.m_bound      = bound;
+    newEntryData.m_generation = m_generation;
+
+    int targetSlot  = -1;
+    int victimSlot  = 0;
+    int victimWorth = INT32_MAX;
+    int victimDepth = 0;
+    int victimAge   = 0;
+
+    for (int slot = 0; slot < BUCKET_SIZE; ++slot)
+    {
+        uint64_t const   data      = bucket.m_entries[slot].m_data.load(std::memory_order_relaxed);
+        uint64_t const   checkKey  = bucket.m_entries[slot].m_checkKey.load(std::memory_order_relaxed);
+        sEntryData const entryData = UnpackEntryData(data);
+
+        if ((checkKey ^ data) == hash && entryData.m_bound != eTTBound::NONE)
+        {
+            // Keep the old best move when this search found none (every move failed low)
+            if (newEntryData.m_move == NULL_PACKED_MOVE) newEntryData.m_move = entryData.m_move;
+
+            bool const isShallower = slot != ALWAYS_REPLACE_SLOT && bound != eTTBound::EXACT && newEntryData.m_depth < entryData.m_depth &&
+                GetEntryAge(entryData, m_generation) == 0;
+
+            targetSlot = isShallower ? ALWAYS_REPLACE_SLOT : slot;
+            break;
+        }
+
+        if (slot == ALWAYS_REPLACE_SLOT) continue;
+
+        int const age   = GetEntryAge(entryData, m_generation);
+        int const worth = entryData.m_bound == eTTBound::NONE ? -1000 : entryData.m_depth - 8 * age;
+
+        if (worth < victimWorth)
+        {
+            victimSlot  = slot;
+            victimWorth = worth;
+            victimDepth = entryData.m_bound == eTTBound::NONE ? -1 : entryData.m_depth;
+            victimAge   = age;
+        }
+    }
+
+    if (targetSlot < 0) targetSlot = victimAge > 0 || newEntryData.m_depth >= victimDepth ? victimSlot : ALWAYS_REPLACE_SLOT;
+
+    uint64_t const data  = PackEntryData(newEntryData);
+    sEntry&        entry = bucket.m_entries[targetSlot];
+
+    entry.m_checkKey.store(hash ^ data, std::memory_order_relaxed);
+    entry.m_data.store(data, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Called once per search, before any thread starts, so this search's entries outrank older ones.
+void ChessTranspositionTable::IncrementGeneration()
+{
+    m_generation = static_cast<uint8_t>((m_generation + 1) & GENERATION_MASK);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ChessTranspositionTable::Clear()
+{
+    for (size_t bucketIndex = 0; bucketIndex < m_bucketCount; ++bucketIndex)
+    {
+        for (sEntry& entry : m_buckets[bucketIndex].m_entries)
+        {
+            entry.m_checkKey.store(0, std::memory_order_relaxed);
+            entry.m_data.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    m_generation = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Samples the first buckets and returns how many of every thousand entries were written by
+/// the current search, as UCI engines report hashfull.
+int ChessTranspositionTable::GetHashFullPermille() const
+{
+    size_t const sampleBucketCount = m_bucketCount < HASH_FULL_SAMPLE ? m_bucketCount : HASH_FULL_SAMPLE;
+    int          usedCount         = 0;
+
+    for (size_t bucketIndex = 0; bucketIndex < sampleBucketCount; ++bucketIndex)
+    {
+        for (sEntry const& entry : m_buckets[bucketIndex].m_entries)
+        {
+            sEntryData const entryData = UnpackEntryData(entry.m_data.load(std::memory_order_relaxed));
+
+            if (entryData.m_bound != eTTBound::NONE && entryData.m_generation == m_generation) ++usedCount;
+        }
+    }
+
+    return static_cast<int>(usedCount * 1000 / (sampleBucketCount * BUCKET_SIZE));
+}
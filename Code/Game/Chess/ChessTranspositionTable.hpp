@@ -0,0 +1,103 @@
+//----------------------------------------------------------------------------------------------------
+// ChessTranspositionTable.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "Game/Chess/ChessMove.hpp"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#include <xmmintrin.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------
+/// @brief How a stored score relates to the true score of the position: exactly it, at least it (the
+/// search failed high on beta) or at most it (no move reached alpha).
+enum class eTTBound : uint8_t
+{
+    NONE,
+    EXACT,
+    LOWER,
+    UPPER
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief What a probe found. m_score is as stored; mate scores still count plies from the stored
+/// node, not from the root.
+struct sTTProbeResult
+{
+    PackedMove m_move  = NULL_PACKED_MOVE;
+    int        m_score = 0;
+    int        m_depth = 0;
+    eTTBound   m_bound = eTTBound::NONE;
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Fixed-size hash -> (move, score, depth, bound) cache shared by every searching thread. Buckets are
+/// one 64-byte cache line of four entries, so a probe touches a single line; Prefetch pulls that line
+/// in while the caller still has work to do. The first three slots are depth-preferred and only give
+/// way to a deeper search or an entry from an older search; the last slot always takes the new
+/// entry, so recent shallow results are not lost.
+///
+/// Like ChessPerftTable, each entry is the packed data and the hash XORed with it. A torn write from
+/// two threads storing at once fails the XOR check and reads as a miss, so no locking is needed.
+/// Every search bumps the 6-bit generation with IncrementGeneration; entries from older generations
+/// are replaced first. The memory is backed by huge pages when the OS provides them.
+class ChessTranspositionTable
+{
+public:
+    explicit ChessTranspositionTable(size_t sizeInMegabytes);
+    ~ChessTranspositionTable();
+
+    ChessTranspositionTable(ChessTranspositionTable const&)            = delete;
+    ChessTranspositionTable& operator=(ChessTranspositionTable const&) = delete;
+
+    bool Probe(uint64_t hash, sTTProbeResult& result) const;
+    void Store(uint64_t hash, PackedMove move, int score, int depth, eTTBound bound);
+    void Prefetch(uint64_t hash) const;
+    void IncrementGeneration();
+    void Clear();
+
+    int    GetHashFullPermille() const;
+    size_t GetBucketCount() const { return m_bucketCount; }
+    size_t GetSizeInBytes() const { return m_bucketCount * sizeof(sBucket); }
+    bool   IsUsingLargePages() const { return m_isUsingLargePages; }
+
+private:
+    struct sEntry
+    {
+        std::atomic<uint64_t> m_checkKey = {0};
+        std::atomic<uint64_t> m_data     = {0};
+    };
+
+    static int constexpr BUCKET_SIZE = 4;    // Slots 0-2 depth-preferred, slot 3 always-replace
+
+    struct alignas(64) sBucket
+    {
+        sEntry m_entries[BUCKET_SIZE];
+    };
+
+    sBucket&       GetBucket(uint64_t const hash) { return m_buckets[hash & (m_bucketCount - 1)]; }
+    sBucket const& GetBucket(uint64_t const hash) const { return m_buckets[hash & (m_bucketCount - 1)]; }
+
+    sBucket* m_buckets           = nullptr;
+    size_t   m_bucketCount       = 0;
+    size_t   m_allocatedBytes    = 0;
+    bool     m_isUsingLargePages = false;
+    uint8_t  m_generation        = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+inline void ChessTranspositionTable::Prefetch(uint64_t const hash) const
+{
+#if defined(_M_X64) || defined(__x86_64__)
+    _mm_prefetch(reinterpret_cast<char const*>(&GetBucket(hash)), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(&GetBucket(hash));
+#endif
+}
@@ -0,0 +1,98 @@
+//----------------------------------------------------------------------------------------------------
+// ChessZobrist.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/ChessZobrist.hpp"
+
+#include "Game/Chess/ChessPosition.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    uint64_t constexpr ZOBRIST_SEED = 0x2545F4914F6CDD1DULL;
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief SplitMix64 step; good enough key quality for hashing and trivially reproducible.
+    uint64_t GetNextRandomKey(uint64_t& state)
+    {
+        state += 0x9E3779B97F4A7C15ULL;
+
+        uint64_t key = state;
+        key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+
+        return key ^ (key >> 31);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sZobristKeys BuildZobristKeys()
+    {
+        sZobristKeys keys;
+        uint64_t     state = ZOBRIST_SEED;
+
+        for (auto& playerKeys : keys.m_pieceKeys)
+        {
+            for (auto& pieceTypeKeys : playerKeys)
+            {
+                for (uint64_t& squareKey : pieceTypeKeys)
+                {
+                    squareKey = GetNextRandomKey(state);
+                }
+            }
+        }
+
+        keys.m_sideToMoveKey = GetNextRandomKey(state);
+
+        for (uint64_t& castlingKey : keys.m_castlingKeys)
+        {
+            castlingKey = GetNextRandomKey(state);
+        }
+
+        // No castling rights hashes to 0 so a bare position only depends on its pieces
+        keys.m_castlingKeys[CASTLE_NONE] = 0;
+
+        for (uint64_t& enPassantFileKey : keys.m_enPassantFileKeys)
+        {
+            enPassantFileKey = GetNextRandomKey(state);
+        }
+
+        return keys;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+sZobristKeys const& GetZobristKeys()
+{
+    static sZobristKeys const s_zobristKeys = BuildZobristKeys();
+    return s_zobristKeys;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Hashes the position from scratch.
+uint64_t ComputeZobristHash(ChessPosition const& position)
+{
+    sZobristKeys const& keys = GetZobristKeys();
+    uint64_t            hash = 0;
+
+    for (int playerId = 0; playerId < NUM_PLAYERS; ++playerId)
+    {
+        for (int pieceType = 0; pieceType < NUM_PIECE_TYPES; ++pieceType)
+        {
+            Bitboard pieces = position.GetPieces(playerId, static_cast<ePieceType>(pieceType));
+
+            while (pieces != 0)
+            {
+                hash ^= keys.m_pieceKeys[playerId][pieceType][PopLowestSquare(pieces)];
+            }
+        }
+    }
+
+    if (position.GetSideToMove() == 1) hash ^= keys.m_sideToMoveKey;
+
+    hash ^= keys.m_castlingKeys[position.GetCastlingRights()];
+
+    if (position.GetEnPassantSquare() != INVALID_SQUARE) hash ^= keys.m_enPassantFileKeys[GetFile(position.GetEnPassantSquare())];
+
+    return hash;
+}
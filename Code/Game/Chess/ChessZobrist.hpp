@@ -0,0 +1,28 @@
+//----------------------------------------------------------------------------------------------------
+// ChessZobrist.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/Chess/ChessCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class ChessPosition;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Random keys for 64-bit Zobrist position hashing. A position's hash is the XOR of the key of every
+/// (player, piece type, square), the side-to-move key when black is to move, the key of the castling
+/// rights mask, and the key of the en passant file when an en passant square is set. The keys come
+/// from a fixed seed so hashes are identical across runs and machines.
+struct sZobristKeys
+{
+    uint64_t m_pieceKeys[NUM_PLAYERS][NUM_PIECE_TYPES][NUM_SQUARES] = {};
+    uint64_t m_sideToMoveKey                                        = 0;
+    uint64_t m_castlingKeys[CASTLE_ALL + 1]                         = {};
+    uint64_t m_enPassantFileKeys[8]                                 = {};
+};
+
+//----------------------------------------------------------------------------------------------------
+sZobristKeys const& GetZobristKeys();
+uint64_t            ComputeZobristHash(ChessPosition const& position);
@@ -0,0 +1,390 @@
+//----------------------------------------------------------------------------------------------------
+// MoveGenerator.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Chess/MoveGenerator.hpp"
+
+#include "Game/Chess/ChessAttacks.hpp"
+#include "Game/Chess/ChessPosition.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    ePieceType constexpr PROMOTION_TYPES[4] = {ePieceType::QUEEN, ePieceType::ROOK, ePieceType::BISHOP, ePieceType::KNIGHT};
+
+    //------------------------------------------------------------------------------------------------
+    void AddMove(MoveList&            moves,
+                 ChessPosition const& position,
+                 int const            fromSquare,
+                 int const            toSquare,
+                 ePieceType const     pieceType,
+                 eChessMoveFlag const flag = eChessMoveFlag::QUIET)
+    {
+        sChessMove move;
+        move.m_fromSquare   = static_cast<int8_t>(fromSquare);
+        move.m_toSquare     = static_cast<int8_t>(toSquare);
+        move.m_pieceType    = pieceType;
+        move.m_capturedType = position.GetPieceType(toSquare);
+        move.m_flag         = move.IsCapture() ? eChessMoveFlag::CAPTURE : flag;
+
+        moves.Push(move);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void AddPawnMove(MoveList&            moves,
+                     ChessPosition const& position,
+                     int const            fromSquare,
+                     int const            toSquare)
+    {
+        int const lastRank = position.GetSideToMove() == 0 ? 7 : 0;
+
+        if (GetRank(toSquare) != lastRank)
+        {
+            AddMove(moves, position, fromSquare, toSquare, ePieceType::PAWN);
+            return;
+        }
+
+        for (ePieceType const promotionType : PROMOTION_TYPES)
+        {
+            AddMove(moves, position, fromSquare, toSquare, ePieceType::PAWN);
+            moves.GetBack().m_promotionType = promotionType;
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief
+    /// Per-position restrictions that make every generated move legal without playing it. Computed
+    /// once per call from the king's square: the pieces giving check, the squares that block or
+    /// capture a single checker, and the ray each pinned piece must stay on.
+    struct sLegalityMasks
+    {
+        bool     m_isLegalOnly      = false;    // False when generating pseudo-legal moves; the masks below are then permissive
+        int      m_kingSquare       = INVALID_SQUARE;
+        Bitboard m_checkers         = 0;
+        Bitboard m_checkMask        = ~0ULL;    // Non-king destinations that resolve a single check; 0 in double check
+        Bitboard m_kingMoveMask     = ~0ULL;    // King destinations the opponent does not attack
+        Bitboard m_enemyAttacks     = 0;        // Opponent's attack map; only filled when it is needed
+        Bitboard m_pinnedPieces     = 0;
+        int      m_pinCount         = 0;
+        int      m_pinnedSquares[8] = {};
+        Bitboard m_pinRays[8]       = {};       // Squares between the king and the pinner, pinner included
+
+        //--------------------------------------------------------------------------------------------
+        Bitboard GetMoveMask(int const fromSquare) const
+        {
+            if ((m_pinnedPieces & GetSquareBit(fromSquare)) == 0) return m_checkMask;
+
+            for (int pinIndex = 0; pinIndex < m_pinCount; ++pinIndex)
+            {
+                if (m_pinnedSquares[pinIndex] == fromSquare) return m_checkMask & m_pinRays[pinIndex];
+            }
+
+            return m_checkMask;
+        }
+    };
+
+    //------------------------------------------------------------------------------------------------
+    bool HasCastlingRights(ChessPosition const& position)
+    {
+        uint8_t const playerRights = position.GetSideToMove() == 0 ? (CASTLE_WHITE_KINGSIDE | CASTLE_WHITE_QUEENSIDE) : (CASTLE_BLACK_KINGSIDE | CASTLE_BLACK_QUEENSIDE);
+        return (position.GetCastlingRights() & playerRights) != 0;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sLegalityMasks ComputePseudoLegalMasks(ChessPosition const& position)
+    {
+        sLegalityMasks masks;
+
+        if (HasCastlingRights(position)) masks.m_enemyAttacks = position.GetAttackedSquares(GetOpponentId(position.GetSideToMove()));
+
+        return masks;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sLegalityMasks ComputeLegalityMasks(ChessPosition const& position)
+    {
+        int const playerId   = position.GetSideToMove();
+        int const opponentId = GetOpponentId(playerId);
+
+        sLegalityMasks masks;
+        masks.m_isLegalOnly  = true;
+        masks.m_kingSquare   = position.GetKingSquare(playerId);
+        masks.m_enemyAttacks = position.GetAttackedSquares(opponentId);
+        masks.m_kingMoveMask = ~masks.m_enemyAttacks;
+
+        // Without a king there is nothing to keep safe
+        if (masks.m_kingSquare == INVALID_SQUARE) return masks;
+
+        int const      kingSquare      = masks.m_kingSquare;
+        Bitboard const occupancy       = position.GetOccupancy();
+        Bitboard const enemyPieces     = position.GetPlayerOccupancy(opponentId);
+        Bitboard const enemyQueens     = position.GetPieces(opponentId, ePieceType::QUEEN);
+        Bitboard const enemyRookLike   = position.GetPieces(opponentId, ePieceType::ROOK) | enemyQueens;
+        Bitboard const enemyBishopLike = position.GetPieces(opponentId, ePieceType::BISHOP) | enemyQueens;
+
+        if (masks.m_enemyAttacks & GetSquareBit(kingSquare))
+        {
+            masks.m_checkers = (GetPawnAttacks(kingSquare, playerId) & position.GetPieces(opponentId, ePieceType::PAWN)) |
+                (GetKnightAttacks(kingSquare) & position.GetPieces(opponentId, ePieceType::KNIGHT)) |
+                (GetBishopAttacks(kingSquare, occupancy) & enemyBishopLike) |
+                (GetRookAttacks(kingSquare, occupancy) & enemyRookLike);
+
+            // A single check is answered by capturing the checker or blocking its ray; a double check only by a king move
+            masks.m_checkMask = PopCount(masks.m_checkers) == 1 ? masks.m_checkers | GetSquaresBetween(kingSquare, GetLowestSquare(masks.m_checkers)) : 0;
+        }
+
+        // Sliders that would see the king if our own pieces were transparent; exactly one of ours in between is pinned
+        Bitboard snipers = (GetBishopAttacks(kingSquare, enemyPieces) & enemyBishopLike) | (GetRookAttacks(kingSquare, enemyPieces) & enemyRookLike);
+
+        while (snipers != 0)
+        {
+            int const      sniperSquare = PopLowestSquare(snipers);
+            Bitboard const between      = GetSquaresBetween(kingSquare, sniperSquare);
+            Bitboard const blockers     = between & occupancy;
+
+            if (PopCount(blockers) != 1 || (blockers & enemyPieces) != 0) continue;
+
+            masks.m_pinnedPieces |= blockers;
+            masks.m_pinnedSquares[masks.m_pinCount] = GetLowestSquare(blockers);
+            masks.m_pinRays[masks.m_pinCount]       = between | GetSquareBit(sniperSquare);
+            ++masks.m_pinCount;
+        }
+
+        return masks;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief En passant removes two pieces from one rank, which can expose the king along that rank in
+    /// a way the pin rays do not describe, so it is tested directly against the resulting occupancy.
+    bool IsEnPassantLegal(ChessPosition const&  position,
+                          sLegalityMasks const& masks,
+                          int const             fromSquare,
+                          int const             toSquare)
+    {
+        if (!masks.m_isLegalOnly || masks.m_kingSquare == INVALID_SQUARE) return true;
+
+        int const      playerId           = position.GetSideToMove();
+        int const      opponentId         = GetOpponentId(playerId);
+        int const      kingSquare         = masks.m_kingSquare;
+        Bitboard const capturedPawnBit    = GetSquareBit(GetSquare(GetFile(toSquare), GetRank(fromSquare)));
+        Bitboard const occupancy          = (position.GetOccupancy() ^ GetSquareBit(fromSquare) ^ capturedPawnBit) | GetSquareBit(toSquare);
+        Bitboard const enemyQueens        = position.GetPieces(opponentId, ePieceType::QUEEN);
+        Bitboard const enemyRookLike      = position.GetPieces(opponentId, ePieceType::ROOK) | enemyQueens;
+        Bitboard const enemyBishopLike    = position.GetPieces(opponentId, ePieceType::BISHOP) | enemyQueens;
+        Bitboard const remainingEnemyPawn = position.GetPieces(opponentId, ePieceType::PAWN) & ~capturedPawnBit;
+
+        return ((GetPawnAttacks(kingSquare, playerId) & remainingEnemyPawn) |
+            (GetKnightAttacks(kingSquare) & position.GetPieces(opponentId, ePieceType::KNIGHT)) |
+            (GetBishopAttacks(kingSquare, occupancy) & enemyBishopLike) |
+            (GetRookAttacks(kingSquare, occupancy) & enemyRookLike)) == 0;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void GeneratePawnMoves(ChessPosition const&  position,
+                           sLegalityMasks const& masks,
+                           MoveList&             moves)
+    {
+        int const      playerId        = position.GetSideToMove();
+        int const      forward         = playerId == 0 ? 8 : -8;
+        int const      startRank       = playerId == 0 ? 1 : 6;
+        Bitboard const enemyPieces     = position.GetPlayerOccupancy(GetOpponentId(playerId));
+        int const      enPassantSquare = position.GetEnPassantSquare();
+        Bitboard       pawns           = position.GetPieces(playerId, ePieceType::PAWN);
+
+        while (pawns != 0)
+        {
+            int const      fromSquare = PopLowestSquare(pawns);
+            int const      pushSquare = fromSquare + forward;
+            Bitboard const moveMask   = masks.GetMoveMask(fromSquare);
+
+            if (!position.IsOccupied(pushSquare))
+            {
+                if (moveMask & GetSquareBit(pushSquare)) AddPawnMove(moves, position, fromSquare, pushSquare);
+
+                int const doublePushSquare = pushSquare + forward;
+
+                if (GetRank(fromSquare) == startRank && !position.IsOccupied(doublePushSquare) && (moveMask & GetSquareBit(doublePushSquare)))
+                {
+                    AddMove(moves, position, fromSquare, doublePushSquare, ePieceType::PAWN, eChessMoveFlag::DOUBLE_PAWN_PUSH);
+                }
+            }
+
+            Bitboard const attacks  = GetPawnAttacks(fromSquare, playerId);
+            Bitboard       captures = attacks & enemyPieces & moveMask;
+
+            while (captures != 0)
+            {
+                AddPawnMove(moves, position, fromSquare, PopLowestSquare(captures));
+            }
+
+            if (enPassantSquare != INVALID_SQUARE && (attacks & GetSquareBit(enPassantSquare)) && IsEnPassantLegal(position, masks, fromSquare, enPassantSquare))
+            {
+                AddMove(moves, position, fromSquare, enPassantSquare, ePieceType::PAWN, eChessMoveFlag::EN_PASSANT);
+                moves.GetBack().m_capturedType = ePieceType::PAWN;
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void GeneratePieceMoves(ChessPosition const&  position,
+                            sLegalityMasks const& masks,
+                            MoveList&             moves,
+                            ePieceType const      pieceType)
+    {
+        int const      playerId  = position.GetSideToMove();
+        Bitboard const occupancy = position.GetOccupancy();
+        Bitboard const ownPieces = position.GetPlayerOccupancy(playerId);
+        Bitboard       pieces    = position.GetPieces(playerId, pieceType);
+
+        while (pieces != 0)
+        {
+            int const fromSquare = PopLowestSquare(pieces);
+            Bitboard  targets    = 0;
+
+            switch (pieceType)
+            {
+            case ePieceType::KNIGHT: targets = GetKnightAttacks(fromSquare); break;
+            case ePieceType::BISHOP: targets = GetBishopAttacks(fromSquare, occupancy); break;
+            case ePieceType::ROOK: targets = GetRookAttacks(fromSquare, occupancy); break;
+            case ePieceType::QUEEN: targets = GetQueenAttacks(fromSquare, occupancy); break;
+            case ePieceType::KING: targets = GetKingAttacks(fromSquare); break;
+            default: break;
+            }
+
+            targets &= ~ownPieces & (pieceType == ePieceType::KING ? masks.m_kingMoveMask : masks.GetMoveMask(fromSquare));
+
+            while (targets != 0)
+            {
+                AddMove(moves, position, fromSquare, PopLowestSquare(targets), pieceType);
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Emits castling moves whose rights are intact, whose king and rook stand on their starting
+    /// squares, whose path is empty, and whose king does not start in, pass through, or land on an
+    /// attacked square. The piece check keeps a bad rights byte from creating moves.
+    void GenerateCastlingMoves(ChessPosition const&  position,
+                               sLegalityMasks const& masks,
+                               MoveList&             moves)
+    {
+        int const      playerId       = position.GetSideToMove();
+        int const      backRank       = playerId == 0 ? 0 : 7;
+        uint8_t const  kingsideRight  = playerId == 0 ? CASTLE_WHITE_KINGSIDE : CASTLE_BLACK_KINGSIDE;
+        uint8_t const  queensideRight = playerId == 0 ? CASTLE_WHITE_QUEENSIDE : CASTLE_BLACK_QUEENSIDE;
+        uint8_t const  rights         = position.GetCastlingRights();
+        int const      kingSquare     = GetSquare(4, backRank);
+        Bitboard const occupancy      = position.GetOccupancy();
+        Bitboard const enemyAttacks   = masks.m_enemyAttacks;
+        Bitboard const rooks          = position.GetPieces(playerId, ePieceType::ROOK);
+
+        if ((rights & (kingsideRight | queensideRight)) == 0) return;
+        if ((position.GetPieces(playerId, ePieceType::KING) & GetSquareBit(kingSquare)) == 0) return;
+        if (enemyAttacks & GetSquareBit(kingSquare)) return;
+
+        Bitboard const kingsidePath  = GetSquareBit(GetSquare(5, backRank)) | GetSquareBit(GetSquare(6, backRank));
+        Bitboard const queensidePath = GetSquareBit(GetSquare(3, backRank)) | GetSquareBit(GetSquare(2, backRank));
+        Bitboard const queensideGap  = queensidePath | GetSquareBit(GetSquare(1, backRank));
+
+        if ((rights & kingsideRight) && (rooks & GetSquareBit(GetSquare(7, backRank))) && (occupancy & kingsidePath) == 0 && (enemyAttacks & kingsidePath) == 0)
+        {
+            AddMove(moves, position, kingSquare, GetSquare(6, backRank), ePieceType::KING, eChessMoveFlag::CASTLE_KINGSIDE);
+        }
+
+        if ((rights & queensideRight) && (rooks & GetSquareBit(GetSquare(0, backRank))) && (occupancy & queensideGap) == 0 && (enemyAttacks & queensidePath) == 0)
+        {
+            AddMove(moves, position, kingSquare, GetSquare(2, backRank), ePieceType::KING, eChessMoveFlag::CASTLE_QUEENSIDE);
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void GenerateMoves(ChessPosition const&  position,
+                       sLegalityMasks const& masks,
+                       MoveList&             moves)
+    {
+        // In double check only the king can move
+        if (masks.m_checkMask != 0)
+        {
+            GeneratePawnMoves(position, masks, moves);
+            GeneratePieceMoves(position, masks, moves, ePieceType::KNIGHT);
+            GeneratePieceMoves(position, masks, moves, ePieceType::BISHOP);
+            GeneratePieceMoves(position, masks, moves, ePieceType::ROOK);
+            GeneratePieceMoves(position, masks, moves, ePieceType::QUEEN);
+        }
+
+        GeneratePieceMoves(position, masks, moves, ePieceType::KING);
+
+        if (masks.m_checkers == 0 && HasCastlingRights(position)) GenerateCastlingMoves(position, masks, moves);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void GeneratePseudoLegalMoves(ChessPosition const& position,
+                              MoveList&            moves)
+{
+    GenerateMoves(position, ComputePseudoLegalMasks(position), moves);
+}
+
+//----------------------------------------------------------------------------------------------------
+void GenerateLegalMoves(ChessPosition const& position,
+                        MoveList&            moves)
+{
+    GenerateMoves(position, ComputeLegalityMasks(position), moves);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The make/test/unmake filter GenerateLegalMoves used before the legality masks: every
+/// pseudo-legal move is played on a scratch copy and kept if the mover's king is not attacked.
+void GenerateLegalMovesByMakeTest(ChessPosition const& position,
+                                  MoveList&            moves)
+{
+    int const firstMoveIndex = moves.GetSize();
+
+    GeneratePseudoLegalMoves(position, moves);
+
+    int const     playerId        = position.GetSideToMove();
+    ChessPosition scratchPosition = position;
+    sUndoState    undoState;
+    int           legalMoveCount  = firstMoveIndex;
+
+    for (int moveIndex = firstMoveIndex; moveIndex < moves.GetSize(); ++moveIndex)
+    {
+        scratchPosition.MakeMove(moves[moveIndex], undoState);
+
+        if (!IsKingInCheck(scratchPosition, playerId))
+        {
+            moves[legalMoveCount++] = moves[moveIndex];
+        }
+
+        scratchPosition.UnmakeMove(moves[moveIndex], undoState);
+    }
+
+    moves.Resize(legalMoveCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return True if the player's king is attacked. A player without a king is never in check.
+bool IsKingInCheck(ChessPosition const& position,
+                   int const            playerId)
+{
+    int const kingSquare = position.GetKingSquare(playerId);
+
+    if (kingSquare == INVALID_SQUARE) return false;
+
+    return IsSquareAttacked(position, kingSquare, GetOpponentId(playerId));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Copy-make legality check for a single pseudo-legal move.
+bool IsMoveLegal(ChessPosition const& position,
+                 sChessMove const&    move)
+{
+    int const     playerId     = position.GetSideToMove();
+    ChessPosition nextPosition = position;
+    sUndoState    undoState;
+
+    nextPosition.MakeMove(move, undoState);
+
+    return !IsKingInCheck(nextPosition, playerId);
+}
@@ -0,0 +1,29 @@
+//----------------------------------------------------------------------------------------------------
+// MoveGenerator.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/Chess/ChessMove.hpp"
+
+//----------------------------------------------------------------------------------------------------
+class ChessPosition;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Appends every legal move for the side to move in one pass: pawn pushes, captures, en passant,
+/// promotions to queen/rook/bishop/knight, castling, and piece moves. A move is legal when it does
+/// not leave the mover's king attacked; castling additionally requires the king not to start in,
+/// pass through, or land on an attacked square. Checkers, the check-evasion mask and pin rays are
+/// computed once per position, so no move is played to test it.
+void GenerateLegalMoves(ChessPosition const& position, MoveList& moves);
+
+/// @brief Same move set before the king-safety filter.
+void GeneratePseudoLegalMoves(ChessPosition const& position, MoveList& moves);
+
+/// @brief Reference implementation that filters pseudo-legal moves by playing each one; kept as the
+/// baseline GenerateLegalMoves is benchmarked and cross-checked against.
+void GenerateLegalMovesByMakeTest(ChessPosition const& position, MoveList& moves);
+
+bool IsKingInCheck(ChessPosition const& position, int playerId);
+bool IsMoveLegal(ChessPosition const& position, sChessMove const& move);
@@ -80,6 +80,26 @@ void BoardDefinition::InitializeDefs(char const* path)
     }
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief Finds the definition that sets up the given player's pieces, whose orientation and color
+/// apply to every piece that player owns.
+/// @return nullptr if no definition places a piece for the player.
+BoardDefinition const* BoardDefinition::GetDefByPlayerId(int const playerId)
+{
+    for (BoardDefinition const* boardDef : s_boardDefinitions)
+    {
+        for (sSquareInfo const& squareInfo : boardDef->m_squareInfos)
+        {
+            if (squareInfo.m_name != "DEFAULT" && squareInfo.m_playerControllerId == playerId)
+            {
+                return boardDef;
+            }
+        }
+    }
+
+    return nullptr;
+}
+
 void BoardDefinition::ClearAllDefs()
 {
     for (BoardDefinition const* boardDef : s_boardDefinitions)
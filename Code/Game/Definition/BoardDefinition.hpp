@@ -11,6 +11,10 @@
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Math/IntVec2.hpp"
 
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// One <SquareInfo> entry of the starting setup. Only read while the match is being built; Board
+/// keeps its own compact sBoardSquare records afterwards.
 struct sSquareInfo
 {
     String  m_name               = "DEFAULT";
@@ -18,8 +22,6 @@ struct sSquareInfo
     int     m_playerControllerId = -1;
     Rgba8   m_color              = Rgba8::WHITE;
     IntVec2 m_coords             = IntVec2::ZERO;
-    bool    m_isHighlighted      = false;
-    bool    m_isSelected         = false;
 };
 
 
@@ -32,6 +34,7 @@ struct BoardDefinition
     bool LoadFromXmlElement(XmlElement const* element);
 
     static void                          InitializeDefs(char const* path);
+    static BoardDefinition const*        GetDefByPlayerId(int playerId);
     static std::vector<BoardDefinition*> s_boardDefinitions;
     static void                          ClearAllDefs();
 
@@ -144,6 +144,20 @@ PieceDefinition* PieceDefinition::GetDefByName(String const& name)
     return nullptr;
 }
 
+//----------------------------------------------------------------------------------------------------
+PieceDefinition* PieceDefinition::GetDefByType(ePieceType const pieceType)
+{
+    for (PieceDefinition* pieceDef : s_pieceDefinitions)
+    {
+        if (pieceDef->m_type == pieceType)
+        {
+            return pieceDef;
+        }
+    }
+
+    return nullptr;
+}
+
 void PieceDefinition::ClearAllDefs()
 {
     for (PieceDefinition const* pieceDef : s_pieceDefinitions)
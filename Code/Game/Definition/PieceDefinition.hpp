@@ -15,21 +15,10 @@
 #include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Renderer/Texture.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
+#include "Game/Chess/ChessCommon.hpp"
 
 class Shader;
 
-//----------------------------------------------------------------------------------------------------
-enum class ePieceType : int8_t
-{
-    NONE = -1,
-    PAWN,
-    BISHOP,
-    KNIGHT,
-    ROOK,
-    QUEEN,
-    KING
-};
-
 //----------------------------------------------------------------------------------------------------
 struct sPiecePart
 {
@@ -53,6 +42,7 @@ struct PieceDefinition
 
     static void                          InitializeDefs(char const* path);
     static PieceDefinition*              GetDefByName(String const& name);
+    static PieceDefinition*              GetDefByType(ePieceType pieceType);
     static std::vector<PieceDefinition*> s_pieceDefinitions;
     static void                          ClearAllDefs();
 
@@ -5,8 +5,278 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Framework/AIController.hpp"
 
+#include <algorithm>
+
+#include "Engine/Core/Clock.hpp"
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Game/Chess/ChessTranspositionTable.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/MatchCommon.hpp"
+#include "Game/Gameplay/Game.hpp"
+#include "Game/Gameplay/Match.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    // The search enforces its own hard limit; past this much longer the thread is told to stop
+    double constexpr HARD_LIMIT_GRACE_SECONDS = 0.25;
+
+    // A flagged clock keeps this much, so the next search still gets a (tiny) limit instead of none
+    double constexpr MIN_REMAINING_SECONDS = 0.1;
+
+    //------------------------------------------------------------------------------------------------
+    String GetScoreString(int const score)
+    {
+        if (!IsMateScore(score)) return Stringf("%+.2f", static_cast<float>(score) / 100.f);
+
+        // Mate scores count plies from the root; report full moves like a chess engine would
+        int const matePlies = score > 0 ? SCORE_MATE - score : SCORE_MATE + score;
+
+        return Stringf("mate %s%d", score > 0 ? "" : "-", (matePlies + 1) / 2);
+    }
+}
+
 //----------------------------------------------------------------------------------------------------
 AIController::AIController(Game* owner)
     : Controller(owner)
 {
+    m_clock = new Clock(Clock::GetSystemClock());
+
+    m_threadCount = g_gameConfigBlackboard.GetValue("aiThreads", m_threadCount);
+    SetHashSize(g_gameConfigBlackboard.GetValue("aiHashSizeMB", 16));
+    SetSearchDepth(g_gameConfigBlackboard.GetValue("aiSearchDepth", m_searchLimits.m_depth));
+    SetTimeControl(g_gameConfigBlackboard.GetValue("aiBaseTimeSeconds", 0.f),
+                   g_gameConfigBlackboard.GetValue("aiIncrementSeconds", 0.f),
+                   g_gameConfigBlackboard.GetValue("aiMovesPerControl", 0));
+}
+
+//----------------------------------------------------------------------------------------------------
+AIController::~AIController()
+{
+    CancelSearch();
+    GAME_SAFE_RELEASE(m_search);
+    GAME_SAFE_RELEASE(m_transpositionTable);
+    GAME_SAFE_RELEASE(m_clock);
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIController::Update(float const deltaSeconds)
+{
+    UNUSED(deltaSeconds)
+
+    Match* match = g_theGame->m_match;
+
+    if (IsThinking())
+    {
+        // The match this search belongs to is gone; nothing can use the answer
+        if (match != m_searchMatch)
+        {
+            CancelSearch();
+            return;
+        }
+
+        double const thinkingSeconds = m_clock->GetTotalSeconds() - m_searchStartSeconds;
+
+        if (!m_isSearchFinished.load(std::memory_order_acquire))
+        {
+            if (m_searchLimits.m_hardTimeSeconds > 0.0 && thinkingSeconds > m_searchLimits.m_hardTimeSeconds + HARD_LIMIT_GRACE_SECONDS)
+            {
+                m_isStopRequested.store(true, std::memory_order_relaxed);
+            }
+
+            return;
+        }
+
+        m_searchThread.join();
+
+        if (match->m_position.GetHash() == m_searchPositionHash && match->CanPlayerMove(m_index))
+        {
+            ChargeClock(thinkingSeconds);
+            PlayBestMove(*match);
+        }
+
+        return;
+    }
+
+    if (match == nullptr || !match->CanPlayerMove(m_index)) return;
+
+    StartSearch(*match);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Stops a running search and waits for its thread; its result is discarded.
+void AIController::CancelSearch()
+{
+    if (!IsThinking()) return;
+
+    m_isStopRequested.store(true, std::memory_order_relaxed);
+    m_searchThread.join();
+    m_searchMatch = nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIController::SetSearchDepth(int const depth)
+{
+    m_searchLimits.m_depth = depth < 1 ? 1 : (depth > MAX_SEARCH_DEPTH ? MAX_SEARCH_DEPTH : depth);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Resets the seat's clock. A baseSeconds of 0 turns the clock off.
+void AIController::SetTimeControl(double const baseSeconds,
+                                  double const incrementSeconds,
+                                  int const    movesPerControl)
+{
+    m_baseSeconds                    = std::max(baseSeconds, 0.0);
+    m_movesPerControl                = std::max(movesPerControl, 0);
+    m_timeControl.m_remainingSeconds = m_baseSeconds;
+    m_timeControl.m_incrementSeconds = std::max(incrementSeconds, 0.0);
+    m_timeControl.m_movesToGo        = m_movesPerControl;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Replaces the transposition table with an empty one of the new size, rounded down to a power
+/// of two buckets. Cancels a running search, which would still be using the old table.
+void AIController::SetHashSize(int const sizeInMegabytes)
+{
+    int const clampedSize = sizeInMegabytes < 1 ? 1 : sizeInMegabytes;
+
+    if (m_transpositionTable != nullptr && clampedSize == m_hashSizeInMegabytes) return;
+
+    CancelSearch();
+    GAME_SAFE_RELEASE(m_search);
+    GAME_SAFE_RELEASE(m_transpositionTable);
+
+    m_hashSizeInMegabytes = clampedSize;
+    m_transpositionTable  = new ChessTranspositionTable(static_cast<size_t>(clampedSize));
+    m_search              = new ChessParallelSearch(m_threadCount, m_transpositionTable);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Restarts the search threads. 0 or less uses every hardware thread.
+void AIController::SetThreadCount(int const threadCount)
+{
+    int const clampedCount = threadCount < 0 ? 0 : threadCount;
+
+    if (clampedCount == m_threadCount) return;
+
+    CancelSearch();
+    GAME_SAFE_RELEASE(m_search);
+
+    m_threadCount = clampedCount;
+    m_search      = new ChessParallelSearch(m_threadCount, m_transpositionTable);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The depth cap and clock, as listed by the ChessAI command.
+String AIController::GetDescription() const
+{
+    if (m_baseSeconds <= 0.0) return Stringf("depth %d, %d threads, %d MB hash, no clock", m_searchLimits.m_depth, GetThreadCount(), m_hashSizeInMegabytes);
+
+    String description = Stringf("depth %d, %d threads, %d MB hash, %.1fs + %.1fs", m_searchLimits.m_depth, GetThreadCount(), m_hashSizeInMegabytes,
+                                 m_timeControl.m_remainingSeconds, m_timeControl.m_incrementSeconds);
+
+    if (m_movesPerControl > 0) description += Stringf(", %d of %d moves to the next control", m_timeControl.m_movesToGo, m_movesPerControl);
+
+    return description;
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIController::StartSearch(Match const& match)
+{
+    AllocateMoveTime(m_timeControl, m_searchLimits);
+    m_transpositionTable->IncrementGeneration();
+
+    m_searchMatch        = &match;
+    m_searchPositionHash = match.m_position.GetHash();
+    m_searchStartSeconds = m_clock->GetTotalSeconds();
+    m_isSearchFinished.store(false, std::memory_order_relaxed);
+    m_isStopRequested.store(false, std::memory_order_relaxed);
+    m_searchLimits.m_stopFlag = &m_isStopRequested;
+
+    if (m_searchLimits.m_hardTimeSeconds > 0.0)
+    {
+        g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("AI Player #%d is thinking (clock %.1fs, soft %.2fs, hard %.2fs)...", m_index,
+                                                                 m_timeControl.m_remainingSeconds, m_searchLimits.m_softTimeSeconds, m_searchLimits.m_hardTimeSeconds));
+    }
+    else
+    {
+        g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("AI Player #%d is thinking (depth %d)...", m_index, m_searchLimits.m_depth));
+    }
+
+    // The thread gets its own copies; the match keeps changing underneath it only if the player cancels
+    m_searchThread = std::thread([this, position = match.m_position, hashHistory = match.m_hashHistory, limits = m_searchLimits]()
+    {
+        m_searchResult = m_search->Search(position, hashHistory, limits);
+        m_isSearchFinished.store(true, std::memory_order_release);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIController::ChargeClock(double const thinkingSeconds)
+{
+    if (m_baseSeconds <= 0.0) return;
+
+    m_timeControl.m_remainingSeconds -= thinkingSeconds;
+
+    if (m_timeControl.m_remainingSeconds <= 0.0)
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("AI Player #%d ran out of time", m_index));
+        m_timeControl.m_remainingSeconds = MIN_REMAINING_SECONDS;
+    }
+
+    m_timeControl.m_remainingSeconds += m_timeControl.m_incrementSeconds;
+
+    if (m_movesPerControl > 0 && --m_timeControl.m_movesToGo <= 0)
+    {
+        m_timeControl.m_remainingSeconds += m_baseSeconds;
+        m_timeControl.m_movesToGo = m_movesPerControl;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void AIController::PlayBestMove(Match& match) const
+{
+    sSearchResult const& result = m_searchResult;
+
+    if (!result.HasBestMove())
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("AI Player #%d has no legal move", m_index));
+        return;
+    }
+
+    String const from = match.m_board->ChessCoordToString(GetCoordsFromSquare(result.m_bestMove.m_fromSquare));
+    String const to   = match.m_board->ChessCoordToString(GetCoordsFromSquare(result.m_bestMove.m_toSquare));
+
+    String principalVariation;
+
+    for (sChessMove const& move : result.m_principalVariation)
+    {
+        if (!principalVariation.empty()) principalVariation += " ";
+        principalVariation += GetMoveNotation(move);
+    }
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("AI Player #%d plays %s: depth %d/%d, score %s, %llu nodes in %.3fs (%.0f nodes/s, %d threads), %s",
+                                                             m_index, GetMoveNotation(result.m_bestMove).c_str(), result.m_depth, result.m_selectiveDepth,
+                                                             GetScoreString(result.m_score).c_str(), static_cast<unsigned long long>(result.m_nodeCount),
+                                                             result.m_seconds, result.GetNodesPerSecond(), GetThreadCount(), GetSearchStopReasonName(result.m_stopReason)));
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  PV: %s", principalVariation.c_str()));
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Hash: %.1f%% hits of %llu probes, %d/1000 full%s", result.GetTTHitRate() * 100.0,
+                                                             static_cast<unsigned long long>(result.m_ttProbeCount), m_transpositionTable->GetHashFullPermille(),
+                                                             m_transpositionTable->IsUsingLargePages() ? ", large pages" : ""));
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Ordering: %.1f%% of %llu fail-highs on the first move", result.GetFirstMoveFailHighRate() * 100.0,
+                                                             static_cast<unsigned long long>(result.m_failHighCount)));
+
+    if (m_baseSeconds > 0.0) g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Clock: %.1fs left", m_timeControl.m_remainingSeconds));
+
+    EventArgs args;
+    args.SetValue("from", from);
+    args.SetValue("to", to);
+    args.SetValue("promoteTo", GetPromotionTypeName(result.m_bestMove.m_promotionType));
+    args.SetValue("teleport", "false");
+    args.SetValue("ai", "true");
+
+    g_theEventSystem->FireEvent("ChessMove", args);
 }
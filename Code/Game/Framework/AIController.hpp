@@ -4,11 +4,78 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
-#include "Controller.hpp"
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Chess/ChessParallelSearch.hpp"
+#include "Game/Framework/Controller.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class ChessTranspositionTable;
+class Clock;
+class Match;
 
 //----------------------------------------------------------------------------------------------------
-class AIController : public Controller
+/// @brief
+/// Plays one side of the match. When it is that side's turn, the controller copies the match
+/// position into a ChessParallelSearch running on its own thread, so the frame keeps rendering while it
+/// thinks, and plays the result through the ChessMove event like a click or a network move would.
+/// Each move logs the search depth and nodes per second. A result is thrown away if the position
+/// changed while the search ran.
+///
+/// The seat has its own chess clock. Thinking time is measured with an engine Clock and charged to
+/// it, the increment is added after every move, and with moves per control set, the base time comes
+/// back every time that many moves have been played. Each search gets a soft and hard limit from
+/// what is left. With no base time, the search only stops at the configured depth.
+///
+/// The seat's transposition table lives as long as the controller, so later searches start from what
+/// earlier ones learned. With more than one thread, Lazy SMP helpers search the same root through it.
+class AIController final : public Controller
 {
 public:
     explicit AIController(Game* owner);
+    ~AIController() override;
+
+    void Update(float deltaSeconds) override;
+
+    void CancelSearch();
+    void SetSearchDepth(int depth);
+    void SetTimeControl(double baseSeconds, double incrementSeconds, int movesPerControl);
+    void SetHashSize(int sizeInMegabytes);
+    void SetThreadCount(int threadCount);
+
+    int                 GetSearchDepth() const { return m_searchLimits.m_depth; }
+    sTimeControl const& GetTimeControl() const { return m_timeControl; }
+    double              GetBaseSeconds() const { return m_baseSeconds; }
+    int                 GetMovesPerControl() const { return m_movesPerControl; }
+    int                 GetHashSize() const { return m_hashSizeInMegabytes; }
+    int                 GetThreadCount() const { return m_search->GetThreadCount(); }
+    String              GetDescription() const;
+    bool                IsThinking() const { return m_searchThread.joinable(); }
+
+private:
+    void StartSearch(Match const& match);
+    void ChargeClock(double thinkingSeconds);
+    void PlayBestMove(Match& match) const;
+
+    ChessParallelSearch* m_search = nullptr;
+    sSearchLimits        m_searchLimits;
+    sSearchResult        m_searchResult;                    // Written by the search thread, read once m_isSearchFinished is set
+    std::thread          m_searchThread;
+    std::atomic<bool>    m_isSearchFinished   = {false};
+    std::atomic<bool>    m_isStopRequested    = {false};
+    Match const*         m_searchMatch        = nullptr;    // Match and position the running search started from
+    uint64_t             m_searchPositionHash = 0;
+
+    Clock*       m_clock              = nullptr;
+    double       m_searchStartSeconds = 0.0;    // m_clock time the running search started at
+    sTimeControl m_timeControl;                  // This seat's clock; no base time means no clock
+    double       m_baseSeconds        = 0.0;
+    int          m_movesPerControl    = 0;       // 0 for the whole game on one base time
+
+    ChessTranspositionTable* m_transpositionTable  = nullptr;    // Searched by m_search, so only replaced while idle
+    int                      m_hashSizeInMegabytes = 0;
+    int                      m_threadCount         = 1;          // As configured; 0 for every hardware thread
 };
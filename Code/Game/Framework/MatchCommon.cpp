@@ -4,8 +4,13 @@
 
 #include "Game/Framework/MatchCommon.hpp"
 
+#include <cstdlib>
+
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Game/Chess/ChessCommon.hpp"
+#include "Game/Definition/PieceDefinition.hpp"
+#include "Game/Gameplay/Piece.hpp"
 
 //----------------------------------------------------------------------------------------------------
 char const* GetMoveResultString(eMoveResult const& result)
@@ -69,3 +74,117 @@ bool IsMoveValid(eMoveResult const& result)
     default: ERROR_AND_DIE(Stringf("Unhandled MoveResult enum value #%d", result))
     }
 }
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The result ValidateChessMove gives a legal generated move.
+eMoveResult GetMoveResultFromChessMove(sChessMove const& move)
+{
+    return GetMoveResultFromPackedMove(PackMove(move));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Promotions report VALID_MOVE_PROMOTION whether or not they capture, as ValidatePawnMove does.
+eMoveResult GetMoveResultFromPackedMove(PackedMove const packedMove)
+{
+    if (IsPackedPromotion(packedMove)) return eMoveResult::VALID_MOVE_PROMOTION;
+
+    switch (GetPackedMoveCode(packedMove))
+    {
+    case PACKED_CASTLE_KINGSIDE:  return eMoveResult::VALID_CASTLE_KINGSIDE;
+    case PACKED_CASTLE_QUEENSIDE: return eMoveResult::VALID_CASTLE_QUEENSIDE;
+    case PACKED_CAPTURE:          return eMoveResult::VALID_CAPTURE_NORMAL;
+    case PACKED_EN_PASSANT:       return eMoveResult::VALID_CAPTURE_ENPASSANT;
+    default:                      return eMoveResult::VALID_MOVE_NORMAL;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Packs a move the Match has validated. The piece's current definition supplies the promoted type,
+/// so pack after ExecutePawnPromotion has run. eMoveResult does not say whether a promotion captured,
+/// so promotions are packed as non-captures; UnpackMove reads captures from the position anyway.
+/// @return NULL_PACKED_MOVE for results that are not valid moves.
+PackedMove GetPackedMoveFromPieceMove(sPieceMove const& pieceMove,
+                                      eMoveResult const result)
+{
+    if (!IsMoveValid(result)) return NULL_PACKED_MOVE;
+
+    int const  fromSquare = GetSquareFromCoords(pieceMove.fromCoords);
+    int const  toSquare   = GetSquareFromCoords(pieceMove.toCoords);
+    ePieceType pieceType  = ePieceType::NONE;
+    uint8_t    moveCode   = PACKED_QUIET;
+
+    if (pieceMove.piece != nullptr && pieceMove.piece->m_definition != nullptr) pieceType = pieceMove.piece->m_definition->m_type;
+
+    switch (result)
+    {
+    case eMoveResult::VALID_CASTLE_KINGSIDE:   moveCode = PACKED_CASTLE_KINGSIDE; break;
+    case eMoveResult::VALID_CASTLE_QUEENSIDE:  moveCode = PACKED_CASTLE_QUEENSIDE; break;
+    case eMoveResult::VALID_CAPTURE_NORMAL:    moveCode = PACKED_CAPTURE; break;
+    case eMoveResult::VALID_CAPTURE_ENPASSANT: moveCode = PACKED_EN_PASSANT; break;
+    case eMoveResult::VALID_MOVE_PROMOTION:
+        switch (pieceType)
+        {
+        case ePieceType::KNIGHT: moveCode = PACKED_PROMOTION | 0; break;
+        case ePieceType::BISHOP: moveCode = PACKED_PROMOTION | 1; break;
+        case ePieceType::ROOK:   moveCode = PACKED_PROMOTION | 2; break;
+        default:                 moveCode = PACKED_PROMOTION | 3; break;
+        }
+        break;
+    default:
+        if (pieceType == ePieceType::PAWN && abs(pieceMove.toCoords.y - pieceMove.fromCoords.y) == 2) moveCode = PACKED_DOUBLE_PAWN_PUSH;
+        break;
+    }
+
+    return static_cast<PackedMove>(fromSquare | (toSquare << 6) | (moveCode << 12));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @param piece The piece that made the move, which ends up on the packed to square.
+sPieceMove GetPieceMoveFromPackedMove(PackedMove const packedMove,
+                                      Piece const*     piece)
+{
+    return sPieceMove{piece, GetCoordsFromSquare(GetPackedFromSquare(packedMove)), GetCoordsFromSquare(GetPackedToSquare(packedMove))};
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Converts 1-based board coords (a1 = (1, 1)) to a ChessPosition square index (a1 = 0).
+int GetSquareFromCoords(IntVec2 const& coords)
+{
+    return GetSquare(coords.x - 1, coords.y - 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+IntVec2 GetCoordsFromSquare(int const square)
+{
+    return IntVec2(GetFile(square) + 1, GetRank(square) + 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief FEN fields are separated by spaces, which an unquoted console or network argument cannot
+/// carry, so FENs travel as arguments with '_' in place of each space.
+std::string EncodeFENArgument(std::string const& fen)
+{
+    std::string fenArgument = fen;
+
+    for (char& fenChar : fenArgument)
+    {
+        if (fenChar == ' ') fenChar = '_';
+    }
+
+    return fenArgument;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Reverses EncodeFENArgument. A FEN that was passed quoted, spaces and all, comes back unchanged.
+std::string DecodeFENArgument(std::string const& fenArgument)
+{
+    std::string fen = fenArgument;
+
+    for (char& fenChar : fen)
+    {
+        if (fenChar == '_') fenChar = ' ';
+    }
+
+    return fen;
+}
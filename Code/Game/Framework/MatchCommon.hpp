@@ -5,8 +5,10 @@
 //----------------------------------------------------------------------------------------------------
 #pragma once
 #include <cstdint>
+#include <string>
 
 #include "Engine/Math/IntVec2.hpp"
+#include "Game/Chess/ChessMove.hpp"
 
 class Piece;
 
@@ -62,3 +64,11 @@ enum class eChessGameState : uint8_t
 
 char const* GetMoveResultString(eMoveResult const& result);
 bool        IsMoveValid(eMoveResult const& result);
+eMoveResult GetMoveResultFromChessMove(sChessMove const& move);
+eMoveResult GetMoveResultFromPackedMove(PackedMove packedMove);
+PackedMove  GetPackedMoveFromPieceMove(sPieceMove const& pieceMove, eMoveResult result);
+sPieceMove  GetPieceMoveFromPackedMove(PackedMove packedMove, Piece const* piece);
+int         GetSquareFromCoords(IntVec2 const& coords);
+IntVec2     GetCoordsFromSquare(int square);
+std::string EncodeFENArgument(std::string const& fen);
+std::string DecodeFENArgument(std::string const& fenArgument);
@@ -5,6 +5,8 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Gameplay/Board.hpp"
 
+#include <cstring>
+
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Core/VertexUtils.hpp"
@@ -26,6 +28,8 @@ Board::Board(Match* owner)
     : Actor(owner)
 
 {
+    memset(m_boardImage, '.', sizeof(m_boardImage));
+
     m_shader                   = g_theRenderer->CreateOrGetShaderFromFile("Data/Shaders/BlinnPhong", eVertexType::VERTEX_PCUTBN);
     m_diffuseTexture           = g_theRenderer->CreateOrGetTextureFromFile("Data/Images/PhongTextures/FunkyBricks_d.png");
     m_normalTexture            = g_theRenderer->CreateOrGetTextureFromFile("Data/Images/PhongTextures/FunkyBricks_n.png");
@@ -97,11 +101,13 @@ void Board::RenderSelectedBox() const
 {
     VertexList_PCU verts;
 
-    for (sSquareInfo const& info : m_squareInfoList)
+    for (int y = 1; y <= 8; ++y)
     {
-        if (info.m_isSelected || info.m_isHighlighted)
+        for (int x = 1; x <= 8; ++x)
         {
-            AddVertsForWireframeAABB3D(verts, GetAABB3FromCoords(info.m_coords, 0.2f), 0.01f);
+            if (m_squares[y - 1][x - 1].m_flags == SQUARE_FLAG_NONE) continue;
+
+            AddVertsForWireframeAABB3D(verts, GetAABB3FromCoords(IntVec2(x, y), 0.2f), 0.01f);
         }
     }
 
@@ -173,32 +179,40 @@ Vec3 Board::GetWorldPositionByCoords(IntVec2 const& coords)
 //----------------------------------------------------------------------------------------------------
 Piece* Board::GetPieceByCoords(IntVec2 const& coords) const
 {
-    for (Piece* piece : m_match->m_pieceList)
-    {
-        if (piece == nullptr)
-        {
-            continue;
-        }
-        if (piece->m_coords == coords)
-        {
-            return piece;
-        }
-    }
+    if (!IsCoordValid(coords)) return nullptr;
+
+    return m_pieceBySquare[GetSquareFromCoords(coords)];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Invalid coords read as an empty square.
+sBoardSquare const& Board::GetSquareByCoords(IntVec2 const& coords) const
+{
+    static sBoardSquare const s_emptySquare;
 
-    return nullptr;
+    if (!IsCoordValid(coords)) return s_emptySquare;
+
+    return m_squares[coords.y - 1][coords.x - 1];
 }
 
-sSquareInfo Board::GetSquareInfoByCoords(IntVec2 const& coords)
+//----------------------------------------------------------------------------------------------------
+/// @brief Finds the first square, in a1..h8 order, that has the flag set.
+/// @return false, leaving coords untouched, if no square has it.
+bool Board::FindSquareWithFlag(uint8_t const flag,
+                               IntVec2&      coords) const
 {
-    sSquareInfo returnSquareInfo;
-    for (sSquareInfo squareInfo : m_squareInfoList)
+    for (int y = 1; y <= 8; ++y)
     {
-        if (squareInfo.m_coords == coords)
+        for (int x = 1; x <= 8; ++x)
         {
-            return squareInfo;
+            if ((m_squares[y - 1][x - 1].m_flags & flag) == 0) continue;
+
+            coords = IntVec2(x, y);
+            return true;
         }
     }
-    return returnSquareInfo;
+
+    return false;
 }
 
 IntVec2 Board::StringToChessCoord(String const& chessPos)
@@ -236,14 +250,13 @@ String Board::ChessCoordToString(IntVec2 const& coords)
 
 String Board::GetBoardContents(int const rowNum) const
 {
-    int constexpr colNum = 8;
-    String        result;
+    String result;
 
     // rowNum: 1 ~ 8（最上到最下）
-    int startIndex = (rowNum - 1) * colNum;
-    for (int i = 0; i < colNum; ++i)
+    for (sBoardSquare const& square : m_squares[rowNum - 1])
     {
-        result += m_squareInfoList[startIndex + i].m_notation;
+        char const notation = GetPieceNotation(square.m_pieceType, square.m_playerId);
+        result += notation != '\0' ? notation : '*';
     }
 
     return result;
@@ -316,80 +329,106 @@ void Board::CreateLocalVertsForBoardFrame()
     AddVertsForAABB3D(m_vertexes, m_indexes, rightFrame, Rgba8(40, 50, 60));
 }
 
-void Board::UpdateSquareInfoList(IntVec2 const& toCoords)
+//----------------------------------------------------------------------------------------------------
+void Board::SetSquareByCoords(IntVec2 const&   coords,
+                              ePieceType const pieceType,
+                              int const        playerId)
 {
-    sSquareInfo const fromInfo = GetSquareInfoByCoords(toCoords);
+    if (!IsCoordValid(coords)) return;
 
-    for (auto it = m_squareInfoList.begin(); it != m_squareInfoList.end(); ++it)
-    {
-        if (it->m_coords == toCoords)
-        {
-            it->m_name               = "DEFAULT";
-            it->m_notation           = "*";
-            it->m_playerControllerId = -1;
-        }
-    }
+    sBoardSquare& square = m_squares[coords.y - 1][coords.x - 1];
+    square.m_pieceType   = pieceType;
+    square.m_playerId    = static_cast<int8_t>(playerId);
+
+    // Every square change passes through here, so the board image never needs a rebuild
+    char const notation = GetPieceNotation(pieceType, playerId);
+
+    m_boardImage[(8 - coords.y) * 8 + coords.x - 1] = notation != '\0' ? notation : '.';
 }
 
-void Board::UpdateSquareInfoList(IntVec2 const& fromCoords,
-                                 IntVec2 const& toCoords)
+//----------------------------------------------------------------------------------------------------
+void Board::ClearSquareByCoords(IntVec2 const& coords)
 {
-    sSquareInfo const fromInfo = GetSquareInfoByCoords(fromCoords);
+    SetSquareByCoords(coords, ePieceType::NONE, -1);
+}
 
-    for (auto it = m_squareInfoList.begin(); it != m_squareInfoList.end(); ++it)
-    {
-        if (it->m_coords == toCoords)
-        {
-            it->m_name               = fromInfo.m_name;
-            it->m_notation           = fromInfo.m_notation;
-            it->m_playerControllerId = fromInfo.m_playerControllerId;
-        }
-        else if (it->m_coords == fromCoords)
-        {
-            it->m_name               = "DEFAULT";
-            it->m_notation           = "*";
-            it->m_playerControllerId = -1;
-        }
-    }
+//----------------------------------------------------------------------------------------------------
+/// @brief Moves the piece recorded on fromCoords to toCoords, replacing whatever was recorded there.
+/// Highlight and selection flags stay with their squares.
+void Board::MoveSquareByCoords(IntVec2 const& fromCoords,
+                               IntVec2 const& toCoords)
+{
+    MoveSquareByCoords(fromCoords, toCoords, GetSquareByCoords(fromCoords).m_pieceType);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Board::MoveSquareByCoords(IntVec2 const&   fromCoords,
+                               IntVec2 const&   toCoords,
+                               ePieceType const promotionType)
+{
+    if (fromCoords == toCoords) return;
+
+    int const playerId = GetSquareByCoords(fromCoords).m_playerId;
+
+    SetSquareByCoords(toCoords, promotionType, playerId);
+    ClearSquareByCoords(fromCoords);
 }
 
-void Board::UpdateSquareInfoList(IntVec2 const& fromCoords,
-                                 IntVec2 const& toCoords,
-                                 String const&  promoteTo)
+//----------------------------------------------------------------------------------------------------
+void Board::SetSquareFlag(IntVec2 const& coords,
+                          uint8_t const  flag)
 {
-    sSquareInfo const fromInfo = GetSquareInfoByCoords(fromCoords);
+    if (!IsCoordValid(coords)) return;
 
-    for (auto it = m_squareInfoList.begin(); it != m_squareInfoList.end(); ++it)
+    m_squares[coords.y - 1][coords.x - 1].m_flags |= flag;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Clears the given flags from every square.
+void Board::ClearSquareFlags(uint8_t const flags)
+{
+    for (auto& rank : m_squares)
     {
-        if (it->m_coords == toCoords)
+        for (sBoardSquare& square : rank)
         {
-            it->m_name               = promoteTo;
-            it->m_notation           = 'N';
-            it->m_playerControllerId = fromInfo.m_playerControllerId;
-        }
-        else if (it->m_coords == fromCoords)
-        {
-            it->m_name               = "DEFAULT";
-            it->m_notation           = "*";
-            it->m_playerControllerId = -1;
+            square.m_flags &= static_cast<uint8_t>(~flags);
         }
     }
 }
 
 //----------------------------------------------------------------------------------------------------
-/// @brief Finds the coordinates of the king in `m_squareInfoList` belonging to the specified player.
+void Board::SetPieceByCoords(IntVec2 const& coords, Piece* piece)
+{
+    if (!IsCoordValid(coords)) return;
+
+    m_pieceBySquare[GetSquareFromCoords(coords)] = piece;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Moves the piece actor registered on fromCoords to toCoords. Whatever was registered on
+/// toCoords is overwritten, so captured pieces must be removed before calling this.
+void Board::MovePieceByCoords(IntVec2 const& fromCoords,
+                              IntVec2 const& toCoords)
+{
+    if (fromCoords == toCoords) return;
+
+    SetPieceByCoords(toCoords, GetPieceByCoords(fromCoords));
+    SetPieceByCoords(fromCoords, nullptr);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Finds the coordinates of the king in `m_match->m_position` belonging to the specified player.
 /// @param playerId The ID of the player whose king's position is being queried.
 /// @return Coordinates of the king; returns IntVec2::NEGATIVE_ONE if not found.
 IntVec2 Board::FindKingCoordsByPlayerId(int const playerId) const
 {
-    for (sSquareInfo const& squareInfo : m_squareInfoList)
+    int const kingSquare = m_match->m_position.GetKingSquare(playerId);
+
+    if (kingSquare != INVALID_SQUARE)
     {
-        if (squareInfo.m_playerControllerId == playerId && squareInfo.m_name == "king")
-        {
-            return squareInfo.m_coords;
-        }
+        return GetCoordsFromSquare(kingSquare);
     }
 
-    ERROR_RECOVERABLE(Stringf("King not found for player ID %d in m_squareInfoList.", playerId))
+    ERROR_RECOVERABLE(Stringf("King not found for player ID %d in m_position.", playerId))
     return IntVec2::NEGATIVE_ONE;
 }
@@ -9,6 +9,7 @@
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/Shader.hpp"
 #include "Engine/Resource/ResourceHandle.hpp"
+#include "Game/Chess/ChessCommon.hpp"
 #include "Game/Definition/BoardDefinition.hpp"
 #include "Game/Gameplay/Actor.hpp"
 
@@ -19,6 +20,23 @@ class Piece;
 class Texture;
 struct BoardDefinition;
 
+//----------------------------------------------------------------------------------------------------
+// sBoardSquare::m_flags bits
+uint8_t constexpr SQUARE_FLAG_NONE        = 0;
+uint8_t constexpr SQUARE_FLAG_HIGHLIGHTED = 1 << 0;
+uint8_t constexpr SQUARE_FLAG_SELECTED    = 1 << 1;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// What the board shows on one square. Kept to three bytes so the whole board fits in a few cache
+/// lines; piece names and notation are derived from m_pieceType when they are displayed.
+struct sBoardSquare
+{
+    ePieceType m_pieceType = ePieceType::NONE;
+    int8_t     m_playerId  = -1;
+    uint8_t    m_flags     = SQUARE_FLAG_NONE;
+};
+
 //----------------------------------------------------------------------------------------------------
 class Board final : public Actor
 {
@@ -32,29 +50,38 @@ public:
     void  Render() const override;
 
     /// Query
-    Vec3        GetWorldPositionByCoords(IntVec2 const& coords);
-    Piece*      GetPieceByCoords(IntVec2 const& coords) const;
-    sSquareInfo GetSquareInfoByCoords(IntVec2 const& coords);
-    IntVec2     StringToChessCoord(String const& chessPos);
-    String      ChessCoordToString(IntVec2 const& coords);
-    String      GetBoardContents(int rowNum) const;
-    bool        IsCoordValid(IntVec2 const& coords) const;
+    Vec3                GetWorldPositionByCoords(IntVec2 const& coords);
+    Piece*              GetPieceByCoords(IntVec2 const& coords) const;
+    sBoardSquare const& GetSquareByCoords(IntVec2 const& coords) const;
+    char const*         GetBoardImage() const { return m_boardImage; }
+    bool                FindSquareWithFlag(uint8_t flag, IntVec2& coords) const;
+    IntVec2             StringToChessCoord(String const& chessPos);
+    String              ChessCoordToString(IntVec2 const& coords);
+    String              GetBoardContents(int rowNum) const;
+    bool                IsCoordValid(IntVec2 const& coords) const;
 
     /// Render
     void CreateLocalVertsForAABB3s();
     void CreateLocalVertsForBoardFrame();
 
     /// Mutators (non-const methods)
-    void UpdateSquareInfoList(IntVec2 const& toCoords);
-    void UpdateSquareInfoList(IntVec2 const& fromCoords, IntVec2 const& toCoords);
-    void UpdateSquareInfoList(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promoteTo);
+    void SetSquareByCoords(IntVec2 const& coords, ePieceType pieceType, int playerId);
+    void ClearSquareByCoords(IntVec2 const& coords);
+    void MoveSquareByCoords(IntVec2 const& fromCoords, IntVec2 const& toCoords);
+    void MoveSquareByCoords(IntVec2 const& fromCoords, IntVec2 const& toCoords, ePieceType promotionType);
+    void SetSquareFlag(IntVec2 const& coords, uint8_t flag);
+    void ClearSquareFlags(uint8_t flags);
+    void SetPieceByCoords(IntVec2 const& coords, Piece* piece);
+    void MovePieceByCoords(IntVec2 const& fromCoords, IntVec2 const& toCoords);
 
     IntVec2 FindKingCoordsByPlayerId(int playerId) const;
 
-    std::vector<sSquareInfo> m_squareInfoList;
-    std::vector<AABB3>       m_AABBs;
+    std::vector<AABB3> m_AABBs;
 
 private:
+    sBoardSquare      m_squares[8][8];                    // Indexed [coords.y - 1][coords.x - 1]
+    char              m_boardImage[NUM_SQUARES];          // Notation of every square, rank 8 to rank 1 and a to h, '.' when empty
+    Piece*            m_pieceBySquare[NUM_SQUARES] = {};  // Render-side mailbox, indexed like ChessPosition
     BoardDefinition*  m_definition = nullptr;
     VertexList_PCUTBN m_vertexes;
     IndexList         m_indexes;
@@ -5,6 +5,8 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Gameplay/Game.hpp"
 
+#include <algorithm>
+
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
@@ -17,6 +19,7 @@
 #include "Engine/Resource/ResourceLoader/ObjModelLoader.hpp"
 #include "Game/Definition/BoardDefinition.hpp"
 #include "Game/Definition/PieceDefinition.hpp"
+#include "Game/Framework/AIController.hpp"
 #include "Game/Framework/App.hpp"
 #include "Game/Framework/GameCommon.hpp"
 #include "Game/Framework/PlayerController.hpp"
@@ -29,6 +32,7 @@ Game::Game()
     g_theEventSystem->SubscribeEventCallbackFunction("ChessConnect", Event_ChessConnect);
     g_theEventSystem->SubscribeEventCallbackFunction("ChessListen", Event_ChessListen);
     g_theEventSystem->SubscribeEventCallbackFunction("ChessPlayerInfo", Event_ChessPlayerInfo);
+    g_theEventSystem->SubscribeEventCallbackFunction("ChessAI", Event_ChessAI);
     m_gameClock                 = new Clock(Clock::GetSystemClock());
     m_screenCamera              = new Camera();
     Vec2 const bottomLeft       = Vec2::ZERO;
@@ -44,6 +48,13 @@ Game::Game()
 //----------------------------------------------------------------------------------------------------
 Game::~Game()
 {
+    // AI search threads must be joined before anything they read goes away
+    for (AIController*& aiController : m_aiControllerList)
+    {
+        GAME_SAFE_RELEASE(aiController);
+    }
+
+    m_aiControllerList.clear();
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -279,6 +290,78 @@ bool Game::Event_ChessPlayerInfo(EventArgs& args)
     return true;
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief ChessAI [player=0|1|both] [enable=true|false] [depth=N] [time=S] [inc=S] [movestogo=N] [hash=MB] [threads=N]
+/// Hands a seat to the computer (enable=true, the default) or back to the mouse. depth= caps how many
+/// plies the AI searches. time= resets the seat's clock to S seconds (0 for no clock, so only depth
+/// stops the search), inc= is added after every move, and movestogo= gives the base time back every N
+/// moves (0 for the whole game). hash= replaces the seat's transposition table with an empty one of
+/// that many megabytes, and threads= sets how many threads search it (0 for every hardware thread).
+/// Anything left out keeps its current value, which for a new seat is the ai* settings in
+/// GameConfig.xml. With no player=, lists which seats the AI plays.
+bool Game::Event_ChessAI(EventArgs& args)
+{
+    if (!g_theGame) return false;
+
+    String const player      = args.GetValue("player", "");
+    bool const   isEnabled   = args.GetValue("enable", true);
+    int const    searchDepth = args.GetValue("depth", 0);
+    float const  baseSeconds = args.GetValue("time", -1.f);
+    float const  increment   = args.GetValue("inc", -1.f);
+    int const    movesToGo   = args.GetValue("movestogo", -1);
+    int const    hashSize    = args.GetValue("hash", 0);
+    int const    threadCount = args.GetValue("threads", -1);
+
+    if (player.empty())
+    {
+        for (int id = 0; id < 2; ++id)
+        {
+            AIController const* aiController = g_theGame->GetAIPlayer(id);
+
+            if (aiController == nullptr) g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Player #%d: human", id));
+            else g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Player #%d: AI, %s", id, aiController->GetDescription().c_str()));
+        }
+
+        return true;
+    }
+
+    if (player != "0" && player != "1" && player != "both")
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, "ChessAI player= must be 0, 1 or both");
+        return false;
+    }
+
+    for (int id = 0; id < 2; ++id)
+    {
+        if (player != "both" && player != Stringf("%d", id)) continue;
+
+        AIController* aiController = g_theGame->SetAIPlayer(id, isEnabled);
+
+        if (aiController == nullptr)
+        {
+            g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Player #%d is now played by a human", id));
+            continue;
+        }
+
+        if (searchDepth > 0) aiController->SetSearchDepth(searchDepth);
+        if (hashSize > 0) aiController->SetHashSize(hashSize);
+        if (threadCount >= 0) aiController->SetThreadCount(threadCount);
+
+        if (baseSeconds >= 0.f || increment >= 0.f || movesToGo >= 0)
+        {
+            sTimeControl const& timeControl = aiController->GetTimeControl();
+
+            aiController->SetTimeControl(baseSeconds >= 0.f ? baseSeconds : aiController->GetBaseSeconds(),
+                                         increment >= 0.f ? increment : timeControl.m_incrementSeconds,
+                                         movesToGo >= 0 ? movesToGo : aiController->GetMovesPerControl());
+        }
+
+        g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Player #%d is now played by the AI (%s)", id, aiController->GetDescription().c_str()));
+    }
+
+    return true;
+}
+
 eGameState Game::GetCurrentGameState() const
 {
     return m_gameState;
@@ -309,6 +392,12 @@ bool Game::IsFixedCameraMode() const
     return m_isFixedCameraMode;
 }
 
+//----------------------------------------------------------------------------------------------------
+bool Game::IsAIPlayer(int const id) const
+{
+    return GetAIPlayer(id) != nullptr;
+}
+
 PlayerController* Game::GetCurrentPlayer()
 {
     for (PlayerController* m_localPlayerController : m_localPlayerControllerList)
@@ -416,6 +505,13 @@ void Game::UpdateFromInput()
 void Game::UpdateEntities(float const gameDeltaSeconds, float const systemDeltaSeconds) const
 {
     UNUSED(gameDeltaSeconds)
+
+    // AI controllers also run without a match, so a search for a match that has ended gets cancelled
+    for (AIController* aiController : m_aiControllerList)
+    {
+        aiController->Update(systemDeltaSeconds);
+    }
+
     if (m_match == nullptr) return;
     m_match->Update();
     GetLocalPlayer(m_currentPlayerControllerId)->Update(systemDeltaSeconds);
@@ -518,3 +614,40 @@ PlayerController* Game::GetLocalPlayer(int const id) const
 
     return nullptr;
 }
+
+//----------------------------------------------------------------------------------------------------
+AIController* Game::GetAIPlayer(int const id) const
+{
+    for (AIController* aiController : m_aiControllerList)
+    {
+        if (aiController->GetControllerIndex() == id) return aiController;
+    }
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Creates or removes the AIController for a seat and returns it, or nullptr once removed.
+AIController* Game::SetAIPlayer(int const  id,
+                               bool const isEnabled)
+{
+    AIController* aiController = GetAIPlayer(id);
+
+    if (!isEnabled)
+    {
+        if (aiController == nullptr) return nullptr;
+
+        m_aiControllerList.erase(std::find(m_aiControllerList.begin(), m_aiControllerList.end(), aiController));
+        GAME_SAFE_RELEASE(aiController);
+        return nullptr;
+    }
+
+    if (aiController == nullptr)
+    {
+        aiController = new AIController(this);
+        aiController->SetControllerIndex(id);
+        m_aiControllerList.push_back(aiController);
+    }
+
+    return aiController;
+}
@@ -11,6 +11,7 @@
 #include "Engine/Math/FloatRange.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
+class AIController;
 class Camera;
 class Clock;
 class Match;
@@ -40,12 +41,14 @@ public:
     static bool Event_ChessConnect(EventArgs& args);
     static bool Event_ChessListen(EventArgs& args);
     static bool Event_ChessPlayerInfo(EventArgs& args);
+    static bool Event_ChessAI(EventArgs& args);
 
     eGameState        GetCurrentGameState() const;
     int               GetCurrentPlayerControllerId() const;
     void              TogglePlayerControllerId();
     void              ChangeGameState(eGameState newGameState);
     bool              IsFixedCameraMode() const;
+    bool              IsAIPlayer(int id) const;
     PlayerController* GetCurrentPlayer();
     Match*            m_match = nullptr;
 
@@ -57,12 +60,15 @@ private:
     void              RenderEntities() const;
     PlayerController* CreateLocalPlayer(int id);
     PlayerController* GetLocalPlayer(int id) const;
+    AIController*     GetAIPlayer(int id) const;
+    AIController*     SetAIPlayer(int id, bool isEnabled);
 
     Camera*                        m_screenCamera = nullptr;
     AABB2                          m_screenSpace  = AABB2::ZERO_TO_ONE;
     eGameState                     m_gameState    = eGameState::ATTRACT;
     Clock*                         m_gameClock    = nullptr;
     std::vector<PlayerController*> m_localPlayerControllerList;
+    std::vector<AIController*>     m_aiControllerList;    // Seats played by the computer; the seat's PlayerController still owns the camera
     int                            m_currentPlayerControllerId = -1;
     bool                           m_isFixedCameraMode         = false;
     int                            m_currentDebugInt           = 0;
@@ -5,6 +5,9 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Gameplay/Match.hpp"
 
+#include <cstdlib>
+#include <cstring>
+
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
@@ -15,6 +18,12 @@
 #include "Engine/Platform/Window.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Game/Chess/ChessAttacks.hpp"
+#include "Game/Chess/ChessPerft.hpp"
+#include "Game/Chess/ChessPerftTable.hpp"
+#include "Game/Chess/ChessTestPositions.hpp"
+#include "Game/Chess/ChessThreadPool.hpp"
+#include "Game/Chess/MoveGenerator.hpp"
 #include "Game/Definition/BoardDefinition.hpp"
 #include "Game/Definition/PieceDefinition.hpp"
 #include "Game/Framework/GameCommon.hpp"
@@ -35,6 +44,8 @@ Match::Match()
     g_theEventSystem->SubscribeEventCallbackFunction("OnEnterMatchTurn", OnEnterMatchTurn);
     g_theEventSystem->SubscribeEventCallbackFunction("OnExitMatchTurn", OnExitMatchTurn);
     g_theEventSystem->SubscribeEventCallbackFunction("OnMatchInitialized", OnMatchInitialized);
+    g_theEventSystem->SubscribeEventCallbackFunction("ChessPerft", OnChessPerft);
+    g_theEventSystem->SubscribeEventCallbackFunction("ChessLoadFEN", OnChessLoadFEN);
 
     m_screenCamera = new Camera();
 
@@ -57,17 +68,23 @@ Match::Match()
     {
         for (sSquareInfo const& squareInfo : boardDefs->m_squareInfos)
         {
-            m_board->m_squareInfoList.push_back(squareInfo);
-
             if (squareInfo.m_name == "DEFAULT") continue;
 
             Piece* piece         = new Piece(this, squareInfo);
             piece->m_orientation = boardDefs->m_pieceOrientation;
             piece->m_color       = boardDefs->m_pieceColor;
             m_pieceList.push_back(piece);
+            m_board->SetPieceByCoords(squareInfo.m_coords, piece);
+            m_board->SetSquareByCoords(squareInfo.m_coords, piece->m_definition->m_type, squareInfo.m_playerControllerId);
+            m_position.AddPiece(GetSquareFromCoords(squareInfo.m_coords), piece->m_definition->m_type, squareInfo.m_playerControllerId);
         }
     }
 
+    m_position.InitializeCastlingRights();
+    m_position.SetSideToMove(g_theGame->GetCurrentPlayerControllerId());
+    m_hashHistory.Push(m_position.GetHash());
+    m_moveCache.Refresh(m_position);
+
     // #if defined DEBUG_MODE
     DebugAddWorldBasis(Mat44(), -1.f);
 
@@ -88,6 +105,8 @@ Match::Match()
 Match::~Match()
 {
     UnregisterNetworkCommands();
+    g_theEventSystem->UnsubscribeEventCallbackFunction("ChessPerft", OnChessPerft);
+    g_theEventSystem->UnsubscribeEventCallbackFunction("ChessLoadFEN", OnChessLoadFEN);
 
     GAME_SAFE_RELEASE(m_screenCamera);
     GAME_SAFE_RELEASE(m_board);
@@ -100,6 +119,89 @@ Match::~Match()
     m_pieceList.clear();
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief Replaces the match position with the one a FEN string describes and rebuilds the piece
+/// actors and Board squares to match. Move and repetition history start over from the new position.
+/// The caller is responsible for handing the turn to the position's side to move.
+/// @return False, leaving the match untouched, if the FEN is malformed or either side has no king.
+bool Match::LoadFromFEN(std::string const& fen)
+{
+    ChessPosition position;
+
+    if (!position.LoadFromFEN(fen)) return false;
+    if (position.GetKingSquare(0) == INVALID_SQUARE || position.GetKingSquare(1) == INVALID_SQUARE) return false;
+
+    for (int i = 0; i < static_cast<int>(m_pieceList.size()); ++i)
+    {
+        GAME_SAFE_RELEASE(m_pieceList[i]);
+    }
+
+    m_pieceList.clear();
+    m_selectedPiece    = nullptr;
+    m_showGhostPiece   = false;
+    m_ghostSourcePiece = nullptr;
+    m_board->ClearSquareFlags(SQUARE_FLAG_SELECTED | SQUARE_FLAG_HIGHLIGHTED);
+
+    for (int square = 0; square < NUM_SQUARES; ++square)
+    {
+        IntVec2 const    coords    = GetCoordsFromSquare(square);
+        ePieceType const pieceType = position.GetPieceType(square);
+
+        m_board->SetPieceByCoords(coords, nullptr);
+        m_board->ClearSquareByCoords(coords);
+
+        if (pieceType == ePieceType::NONE) continue;
+
+        int const              playerId = position.GetPlayerId(square);
+        BoardDefinition const* boardDef = BoardDefinition::GetDefByPlayerId(playerId);
+
+        sSquareInfo squareInfo;
+        squareInfo.m_name               = PieceDefinition::GetDefByType(pieceType)->m_name;
+        squareInfo.m_playerControllerId = playerId;
+        squareInfo.m_coords             = coords;
+
+        Piece* piece = new Piece(this, squareInfo);
+
+        if (boardDef != nullptr)
+        {
+            piece->m_orientation = boardDef->m_pieceOrientation;
+            piece->m_color       = boardDef->m_pieceColor;
+        }
+
+        m_pieceList.push_back(piece);
+        m_board->SetPieceByCoords(coords, piece);
+        m_board->SetSquareByCoords(coords, pieceType, playerId);
+    }
+
+    m_position = position;
+    m_moveHistory.clear();
+    m_hashHistory.Clear();
+    m_hashHistory.Push(m_position.GetHash());
+    m_moveCache.Refresh(m_position);
+    InvalidateSelectionDestinations();
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::string Match::GetFEN() const
+{
+    return m_position.ToFEN();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Whether a move by this player would be accepted right now: it is the player's turn, the
+/// game is not over, in a network game the player is the local side, and there is a legal move.
+bool Match::CanPlayerMove(int const playerId)
+{
+    if (m_gameState == eChessGameState::GAME_OVER) return false;
+    if (m_position.GetSideToMove() != playerId) return false;
+    if (g_theGame->GetCurrentPlayerControllerId() != playerId) return false;
+    if (m_isConnected && !IsMyTurn()) return false;
+
+    return !m_moveCache.GetLegalMoves(m_position).IsEmpty();
+}
+
 void Match::Update()
 {
     float const deltaSeconds = static_cast<float>(m_gameClock->GetDeltaSeconds());
@@ -136,16 +238,11 @@ void Match::Update()
     // 如果沒有 piece 被選中，檢查是否有 board square 被選中
     if (!hasAnySelection)
     {
-        for (int i = 0; i < (int)m_board->m_squareInfoList.size(); ++i)
+        if (m_board->FindSquareWithFlag(SQUARE_FLAG_SELECTED, selectedSquareCoords))
         {
-            if (m_board->m_squareInfoList[i].m_isSelected)
-            {
-                hasAnySelection      = true;
-                hasSelectedSquare    = true;
-                selectedSquareCoords = m_board->m_squareInfoList[i].m_coords;
-                m_selectedPiece      = m_board->GetPieceByCoords(selectedSquareCoords);
-                break;
-            }
+            hasAnySelection   = true;
+            hasSelectedSquare = true;
+            m_selectedPiece   = m_board->GetPieceByCoords(selectedSquareCoords);
         }
     }
 
@@ -159,14 +256,11 @@ void Match::Update()
         Ray3 ray                        = Ray3(currentPlayer->m_position, currentPlayerForwardNormal, 100.f);
 
         float minLength        = FLOAT_MAX;
-        int   closestAABBIndex = -1;
+        int   closestSquare    = -1;
         bool  foundImpact      = false;
 
         // 清除所有 highlight
-        for (int i = 0; i < (int)m_board->m_squareInfoList.size(); ++i)
-        {
-            m_board->m_squareInfoList[i].m_isHighlighted = false;
-        }
+        m_board->ClearSquareFlags(SQUARE_FLAG_HIGHLIGHTED);
 
         for (Piece* piece : m_pieceList)
         {
@@ -181,24 +275,23 @@ void Match::Update()
         m_ghostSourcePiece = nullptr;
 
         // Check board AABBs for raycast
-        for (int i = 0; i < (int)m_board->m_squareInfoList.size(); ++i)
+        for (int square = 0; square < NUM_SQUARES; ++square)
         {
-            RaycastResult3D const result = RaycastVsAABB3D(ray.m_startPosition, ray.m_forwardNormal, ray.m_maxLength,
-                                                           m_board->GetAABB3FromCoords(m_board->m_squareInfoList[i].m_coords, 0.2f).m_mins,
-                                                           m_board->GetAABB3FromCoords(m_board->m_squareInfoList[i].m_coords, 0.2f).m_maxs);
+            AABB3 const           squareAABB3 = m_board->GetAABB3FromCoords(GetCoordsFromSquare(square), 0.2f);
+            RaycastResult3D const result      = RaycastVsAABB3D(ray.m_startPosition, ray.m_forwardNormal, ray.m_maxLength, squareAABB3.m_mins, squareAABB3.m_maxs);
 
             if (result.m_didImpact && result.m_impactLength < minLength)
             {
                 minLength        = result.m_impactLength;
-                closestAABBIndex = i;
+                closestSquare    = square;
                 foundImpact      = true;
             }
         }
 
         // 如果找到了 raycast 目標，檢查是否為有效移動位置
-        if (foundImpact && closestAABBIndex != -1)
+        if (foundImpact && closestSquare != -1)
         {
-            IntVec2 targetCoords = m_board->m_squareInfoList[closestAABBIndex].m_coords;
+            IntVec2 targetCoords = GetCoordsFromSquare(closestSquare);
             IntVec2 fromCoords;
             bool    canHighlight = false;
             Piece*  sourcePiece  = nullptr;
@@ -208,13 +301,7 @@ void Match::Update()
                 // 有選中的棋子，檢查是否可以移動到目標位置
                 fromCoords             = m_selectedPiece->m_coords;
                 sourcePiece            = m_selectedPiece;
-                eMoveResult moveResult = ValidateChessMove(fromCoords, targetCoords, "", m_isCheatMode);
-                canHighlight           = (moveResult == eMoveResult::VALID_MOVE_NORMAL ||
-                    moveResult == eMoveResult::VALID_CAPTURE_NORMAL ||
-                    moveResult == eMoveResult::VALID_MOVE_PROMOTION ||
-                    moveResult == eMoveResult::VALID_CAPTURE_ENPASSANT ||
-                    moveResult == eMoveResult::VALID_CASTLE_KINGSIDE ||
-                    moveResult == eMoveResult::VALID_CASTLE_QUEENSIDE);
+                canHighlight           = (GetSelectionDestinations(fromCoords) & GetSquareBit(GetSquareFromCoords(targetCoords))) != 0;
             }
             else if (hasSelectedSquare)
             {
@@ -224,20 +311,14 @@ void Match::Update()
                 {
                     fromCoords             = selectedSquareCoords;
                     sourcePiece            = const_cast<Piece*>(pieceOnSelectedSquare);
-                    eMoveResult moveResult = ValidateChessMove(fromCoords, targetCoords, "", m_isCheatMode);
-                    canHighlight           = (moveResult == eMoveResult::VALID_MOVE_NORMAL ||
-                        moveResult == eMoveResult::VALID_CAPTURE_NORMAL ||
-                        moveResult == eMoveResult::VALID_MOVE_PROMOTION ||
-                        moveResult == eMoveResult::VALID_CAPTURE_ENPASSANT ||
-                        moveResult == eMoveResult::VALID_CASTLE_KINGSIDE ||
-                        moveResult == eMoveResult::VALID_CASTLE_QUEENSIDE);
+                    canHighlight           = (GetSelectionDestinations(fromCoords) & GetSquareBit(GetSquareFromCoords(targetCoords))) != 0;
                 }
             }
 
             // 如果是有效移動位置，只進行 highlight（不發送 ChessMove 事件）
             if (canHighlight && sourcePiece != nullptr)
             {
-                m_board->m_squareInfoList[closestAABBIndex].m_isHighlighted = true;
+                m_board->SetSquareFlag(GetCoordsFromSquare(closestSquare), SQUARE_FLAG_HIGHLIGHTED);
                 // 設置 ghost render
                 m_showGhostPiece     = true;
                 m_ghostSourcePiece   = sourcePiece;
@@ -261,20 +342,19 @@ void Match::Update()
 
         float  minLength        = FLOAT_MAX;
         Piece* closestPiece     = nullptr;
-        int    closestAABBIndex = -1;
+        int    closestSquare    = -1;
         bool   foundImpact      = false;
 
         // Check board AABBs
-        for (int i = 0; i < (int)m_board->m_squareInfoList.size(); ++i)
+        for (int square = 0; square < NUM_SQUARES; ++square)
         {
-            RaycastResult3D const result = RaycastVsAABB3D(ray.m_startPosition, ray.m_forwardNormal, ray.m_maxLength,
-                                                           m_board->GetAABB3FromCoords(m_board->m_squareInfoList[i].m_coords, 0.2f).m_mins,
-                                                           m_board->GetAABB3FromCoords(m_board->m_squareInfoList[i].m_coords, 0.2f).m_maxs);
+            AABB3 const           squareAABB3 = m_board->GetAABB3FromCoords(GetCoordsFromSquare(square), 0.2f);
+            RaycastResult3D const result      = RaycastVsAABB3D(ray.m_startPosition, ray.m_forwardNormal, ray.m_maxLength, squareAABB3.m_mins, squareAABB3.m_maxs);
 
             if (result.m_didImpact && result.m_impactLength < minLength)
             {
                 minLength        = result.m_impactLength;
-                closestAABBIndex = i;
+                closestSquare    = square;
                 closestPiece     = nullptr; // Clear piece selection
                 foundImpact      = true;
             }
@@ -296,7 +376,7 @@ void Match::Update()
             {
                 minLength        = result.m_impactLength;
                 closestPiece     = piece;
-                closestAABBIndex = -1; // Clear AABB selection
+                closestSquare    = -1; // Clear AABB selection
                 foundImpact      = true;
             }
         }
@@ -305,15 +385,12 @@ void Match::Update()
         if (foundImpact)
         {
             // Clear all board selections first
-            for (int i = 0; i < (int)m_board->m_squareInfoList.size(); ++i)
-            {
-                m_board->m_squareInfoList[i].m_isHighlighted = false;
-            }
+            m_board->ClearSquareFlags(SQUARE_FLAG_HIGHLIGHTED);
 
             // Set board selection if closest impact was an AABB
-            if (closestAABBIndex != -1)
+            if (closestSquare != -1)
             {
-                m_board->m_squareInfoList[closestAABBIndex].m_isHighlighted = true;
+                m_board->SetSquareFlag(GetCoordsFromSquare(closestSquare), SQUARE_FLAG_HIGHLIGHTED);
             }
 
             // Set piece selection
@@ -325,10 +402,7 @@ void Match::Update()
         else
         {
             // No impacts found, clear all highlights
-            for (int i = 0; i < (int)m_board->m_squareInfoList.size(); ++i)
-            {
-                m_board->m_squareInfoList[i].m_isHighlighted = false;
-            }
+            m_board->ClearSquareFlags(SQUARE_FLAG_HIGHLIGHTED);
 
             for (Piece* piece : m_pieceList)
             {
@@ -390,15 +464,10 @@ void Match::UpdateFromInput(float const deltaSeconds)
         // 檢查 board square 選擇狀態
         if (!hasAnySelection)
         {
-            for (sSquareInfo& info : m_board->m_squareInfoList)
+            if (m_board->FindSquareWithFlag(SQUARE_FLAG_SELECTED, selectedSquareCoords))
             {
-                if (info.m_isSelected)
-                {
-                    hasAnySelection      = true;
-                    hasSelectedSquare    = true;
-                    selectedSquareCoords = info.m_coords;
-                    break;
-                }
+                hasAnySelection   = true;
+                hasSelectedSquare = true;
             }
         }
 
@@ -412,28 +481,27 @@ void Match::UpdateFromInput(float const deltaSeconds)
             Ray3              ray                        = Ray3(currentPlayer->m_position, currentPlayerForwardNormal, 100.f);
 
             float minLength        = FLT_MAX;
-            int   closestAABBIndex = -1;
+            int   closestSquare    = -1;
             bool  foundImpact      = false;
 
             // Check board AABBs for raycast
-            for (int i = 0; i < (int)m_board->m_squareInfoList.size(); ++i)
+            for (int square = 0; square < NUM_SQUARES; ++square)
             {
-                RaycastResult3D const result = RaycastVsAABB3D(ray.m_startPosition, ray.m_forwardNormal, ray.m_maxLength,
-                                                               m_board->GetAABB3FromCoords(m_board->m_squareInfoList[i].m_coords, 0.2f).m_mins,
-                                                               m_board->GetAABB3FromCoords(m_board->m_squareInfoList[i].m_coords, 0.2f).m_maxs);
+                AABB3 const           squareAABB3 = m_board->GetAABB3FromCoords(GetCoordsFromSquare(square), 0.2f);
+                RaycastResult3D const result      = RaycastVsAABB3D(ray.m_startPosition, ray.m_forwardNormal, ray.m_maxLength, squareAABB3.m_mins, squareAABB3.m_maxs);
 
                 if (result.m_didImpact && result.m_impactLength < minLength)
                 {
                     minLength        = result.m_impactLength;
-                    closestAABBIndex = i;
+                    closestSquare    = square;
                     foundImpact      = true;
                 }
             }
 
             // 如果找到了點擊目標，檢查是否為有效移動並執行
-            if (foundImpact && closestAABBIndex != -1)
+            if (foundImpact && closestSquare != -1)
             {
-                IntVec2 targetCoords = m_board->m_squareInfoList[closestAABBIndex].m_coords;
+                IntVec2 targetCoords = GetCoordsFromSquare(closestSquare);
                 IntVec2 fromCoords;
                 bool    canMove = false;
 
@@ -441,13 +509,7 @@ void Match::UpdateFromInput(float const deltaSeconds)
                 {
                     // 有選中的棋子
                     fromCoords             = selectedPiece->m_coords;
-                    eMoveResult moveResult = ValidateChessMove(fromCoords, targetCoords, "", m_isCheatMode);
-                    canMove                = (moveResult == eMoveResult::VALID_MOVE_NORMAL ||
-                        moveResult == eMoveResult::VALID_CAPTURE_NORMAL ||
-                        moveResult == eMoveResult::VALID_MOVE_PROMOTION ||
-                        moveResult == eMoveResult::VALID_CAPTURE_ENPASSANT ||
-                        moveResult == eMoveResult::VALID_CASTLE_KINGSIDE ||
-                        moveResult == eMoveResult::VALID_CASTLE_QUEENSIDE);
+                    canMove                = (GetSelectionDestinations(fromCoords) & GetSquareBit(GetSquareFromCoords(targetCoords))) != 0;
                 }
                 else if (hasSelectedSquare)
                 {
@@ -456,13 +518,7 @@ void Match::UpdateFromInput(float const deltaSeconds)
                     if (pieceOnSelectedSquare != nullptr)
                     {
                         fromCoords             = selectedSquareCoords;
-                        eMoveResult moveResult = ValidateChessMove(fromCoords, targetCoords, "", m_isCheatMode);
-                        canMove                = (moveResult == eMoveResult::VALID_MOVE_NORMAL ||
-                            moveResult == eMoveResult::VALID_CAPTURE_NORMAL ||
-                            moveResult == eMoveResult::VALID_MOVE_PROMOTION ||
-                            moveResult == eMoveResult::VALID_CAPTURE_ENPASSANT ||
-                            moveResult == eMoveResult::VALID_CASTLE_KINGSIDE ||
-                            moveResult == eMoveResult::VALID_CASTLE_QUEENSIDE);
+                        canMove                = (GetSelectionDestinations(fromCoords) & GetSquareBit(GetSquareFromCoords(targetCoords))) != 0;
                     }
                 }
 
@@ -479,11 +535,7 @@ void Match::UpdateFromInput(float const deltaSeconds)
                     g_theEventSystem->FireEvent("ChessMove", args);
 
                     // 移動完成後清除選擇
-                    for (sSquareInfo& info : m_board->m_squareInfoList)
-                    {
-                        info.m_isSelected    = false;
-                        info.m_isHighlighted = false;
-                    }
+                    m_board->ClearSquareFlags(SQUARE_FLAG_SELECTED | SQUARE_FLAG_HIGHLIGHTED);
 
                     for (Piece* piece : m_pieceList)
                     {
@@ -499,14 +551,14 @@ void Match::UpdateFromInput(float const deltaSeconds)
         else
         {
             // 如果沒有任何選擇，允許選擇目前 highlighted 的項目
-            for (sSquareInfo& info : m_board->m_squareInfoList)
+            IntVec2 highlightedCoords;
+
+            if (m_board->FindSquareWithFlag(SQUARE_FLAG_HIGHLIGHTED, highlightedCoords) &&
+                (m_isCheatMode || m_board->GetSquareByCoords(highlightedCoords).m_playerId == g_theGame->GetCurrentPlayerControllerId()))
             {
-                if (info.m_isHighlighted && (m_isCheatMode || info.m_playerControllerId == g_theGame->GetCurrentPlayerControllerId()))
-                {
-                    info.m_isSelected = true;
-                    // 選中後不保持 highlight，因為一旦選中就不允許其他項目 highlight
-                    info.m_isHighlighted = false;
-                }
+                m_board->SetSquareFlag(highlightedCoords, SQUARE_FLAG_SELECTED);
+                // 選中後不保持 highlight，因為一旦選中就不允許其他項目 highlight
+                m_board->ClearSquareFlags(SQUARE_FLAG_HIGHLIGHTED);
             }
 
             for (Piece* piece : m_pieceList)
@@ -525,11 +577,7 @@ void Match::UpdateFromInput(float const deltaSeconds)
     if (g_theInput->WasKeyJustPressed(KEYCODE_RIGHT_MOUSE))
     {
         // 清除所有選擇和 highlight
-        for (sSquareInfo& info : m_board->m_squareInfoList)
-        {
-            info.m_isSelected    = false;
-            info.m_isHighlighted = false;
-        }
+        m_board->ClearSquareFlags(SQUARE_FLAG_SELECTED | SQUARE_FLAG_HIGHLIGHTED);
 
         for (Piece* piece : m_pieceList)
         {
@@ -605,42 +653,93 @@ void Match::ExecuteCapture(IntVec2 const& fromCoords,
 
     if (toPiece == nullptr) return;
 
+    bool const isKingCaptured = toPiece->m_definition->m_type == ePieceType::KING;
+
+    // Remove the captured piece before the capturing piece takes over its square
+    RemovePieceFromPieceList(toCoords);
+    fromPiece->UpdatePositionByCoords(toCoords);
+    IsValidPromotionType(promoteTo) ? m_board->MoveSquareByCoords(fromCoords, toCoords, PieceDefinition::GetDefByName(promoteTo)->m_type) : m_board->MoveSquareByCoords(fromCoords, toCoords);
+    MovePieceOnBoard(fromCoords, toCoords);
+
     // If captured piece is a king, end the match
-    if (toPiece->m_definition->m_type == ePieceType::KING)
+    if (isKingCaptured)
     {
-        fromPiece->UpdatePositionByCoords(toCoords);
-        IsValidPromotionType(promoteTo) ? m_board->UpdateSquareInfoList(fromCoords, toCoords, promoteTo) : m_board->UpdateSquareInfoList(fromCoords, toCoords);
-        RemovePieceFromPieceList(toPiece->m_coords);
-
         g_theDevConsole->AddLine(DevConsole::WARNING, "##################################################");
         g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("[SYSTEM] Player #%d has won the match!", g_theGame->GetCurrentPlayerControllerId()));
         g_theDevConsole->AddLine(DevConsole::WARNING, "##################################################");
         g_theGame->ChangeGameState(eGameState::FINISHED);
     }
-    else
-    {
-        fromPiece->UpdatePositionByCoords(toCoords);
-        IsValidPromotionType(promoteTo) ? m_board->UpdateSquareInfoList(fromCoords, toCoords, promoteTo) : m_board->UpdateSquareInfoList(fromCoords, toCoords);
-        RemovePieceFromPieceList(toPiece->m_coords);
-    }
 }
 
 void Match::RemovePieceFromPieceList(IntVec2 const& toCoords)
 {
-    for (auto it = m_pieceList.begin(); it != m_pieceList.end();)
-    {
-        Piece* piece = *it;
+    Piece* const removedPiece = m_board->GetPieceByCoords(toCoords);
 
-        if (piece->m_coords == toCoords)
-        {
-            delete piece;
+    if (removedPiece == nullptr) return;
 
-            it = m_pieceList.erase(it);
+    m_board->SetPieceByCoords(toCoords, nullptr);
+
+    for (auto it = m_pieceList.begin(); it != m_pieceList.end(); ++it)
+    {
+        if (*it == removedPiece)
+        {
+            m_pieceList.erase(it);
             break;
         }
+    }
+
+    delete removedPiece;
+}
 
-        ++it;
+//----------------------------------------------------------------------------------------------------
+/// @brief Keeps the Board's piece mailbox in sync with a piece actor changing squares.
+/// Any piece on toCoords must already have been removed through RemovePieceFromPieceList.
+void Match::MovePieceOnBoard(IntVec2 const& fromCoords,
+                             IntVec2 const& toCoords)
+{
+    m_board->MovePieceByCoords(fromCoords, toCoords);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Describes a validated move in the form ChessPosition::MakeMove takes.
+sChessMove Match::CreateChessMove(IntVec2 const&    fromCoords,
+                                  IntVec2 const&    toCoords,
+                                  String const&     promoteTo,
+                                  eMoveResult const result) const
+{
+    sChessMove move;
+    move.m_fromSquare   = static_cast<int8_t>(GetSquareFromCoords(fromCoords));
+    move.m_toSquare     = static_cast<int8_t>(GetSquareFromCoords(toCoords));
+    move.m_pieceType    = m_position.GetPieceType(move.m_fromSquare);
+    move.m_capturedType = m_position.GetPieceType(move.m_toSquare);
+
+    switch (result)
+    {
+    case eMoveResult::VALID_CAPTURE_ENPASSANT:
+        move.m_flag         = eChessMoveFlag::EN_PASSANT;
+        move.m_capturedType = ePieceType::PAWN;
+        break;
+    case eMoveResult::VALID_CASTLE_KINGSIDE:
+        move.m_flag     = eChessMoveFlag::CASTLE_KINGSIDE;
+        move.m_toSquare = static_cast<int8_t>(GetSquareFromCoords(IntVec2(7, fromCoords.y)));
+        break;
+    case eMoveResult::VALID_CASTLE_QUEENSIDE:
+        move.m_flag     = eChessMoveFlag::CASTLE_QUEENSIDE;
+        move.m_toSquare = static_cast<int8_t>(GetSquareFromCoords(IntVec2(3, fromCoords.y)));
+        break;
+    default:
+        if (move.IsCapture()) move.m_flag = eChessMoveFlag::CAPTURE;
+        else if (move.m_pieceType == ePieceType::PAWN && abs(toCoords.y - fromCoords.y) == 2) move.m_flag = eChessMoveFlag::DOUBLE_PAWN_PUSH;
+        break;
+    }
+
+    if (move.m_pieceType == ePieceType::PAWN && (toCoords.y == 8 || toCoords.y == 1))
+    {
+        String const promotionType = IsValidPromotionType(promoteTo) ? promoteTo : "queen";
+        move.m_promotionType       = PieceDefinition::GetDefByName(promotionType)->m_type;
     }
+
+    return move;
 }
 
 // bool Match::OnChessMove(EventArgs& args)
@@ -686,6 +785,46 @@ bool Match::OnEnterMatchTurn(EventArgs& args)
 
     g_theDevConsole->AddLine(DevConsole::INPUT_TEXT, Stringf(" +--------+"));
     g_theDevConsole->AddLine(DevConsole::INPUT_TEXT, Stringf("  ABCDEFGH"));
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("FEN: %s", g_theGame->m_match->GetFEN().c_str()));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief ChessLoadFEN fen=FEN
+/// Sets up the board from a FEN, quoted or with '_' in place of spaces, and hands the turn to its side
+/// to move. Not available during a network game, where both peers must keep the same position.
+bool Match::OnChessLoadFEN(EventArgs& args)
+{
+    Match* match = g_theGame->m_match;
+    if (!match) return false;
+
+    std::string const fen = DecodeFENArgument(args.GetValue("fen", ""));
+
+    if (fen.empty())
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, "ChessLoadFEN requires fen= parameter");
+        g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Current FEN: %s", match->GetFEN().c_str()));
+        return false;
+    }
+
+    if (match->m_isConnected)
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, "ChessLoadFEN is not available during a network game");
+        return false;
+    }
+
+    if (!match->LoadFromFEN(fen))
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("ChessLoadFEN: invalid FEN \"%s\"", fen.c_str()));
+        return false;
+    }
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("ChessLoadFEN: loaded \"%s\"", fen.c_str()));
+
+    // OnExitMatchTurn passes the turn over, OnEnterMatchTurn just reprints the board for the current player
+    if (match->m_position.GetSideToMove() != g_theGame->GetCurrentPlayerControllerId()) g_theEventSystem->FireEvent("OnExitMatchTurn");
+    else g_theEventSystem->FireEvent("OnEnterMatchTurn");
 
     return true;
 }
@@ -728,16 +867,17 @@ eMoveResult Match::ValidateChessMove(IntVec2 const& fromCoords,
         return eMoveResult::INVALID_MOVE_BAD_LOCATION;
     }
 
-    // 2. Check if source square has a piece
-    Piece const* fromPiece = m_board->GetPieceByCoords(fromCoords);
+    int const fromSquare = GetSquareFromCoords(fromCoords);
+    int const toSquare   = GetSquareFromCoords(toCoords);
 
-    if (fromPiece == nullptr)
+    // 2. Check if source square has a piece
+    if (!m_position.IsOccupied(fromSquare))
     {
         return eMoveResult::INVALID_MOVE_NO_PIECE;
     }
 
     // 3. Check if piece belongs to current player
-    if (m_board->GetSquareInfoByCoords(fromCoords).m_playerControllerId != g_theGame->GetCurrentPlayerControllerId())
+    if (!m_position.IsOccupiedBy(fromSquare, g_theGame->GetCurrentPlayerControllerId()))
     {
         return eMoveResult::INVALID_MOVE_NOT_YOUR_PIECE;
     }
@@ -749,16 +889,13 @@ eMoveResult Match::ValidateChessMove(IntVec2 const& fromCoords,
     }
 
     // 5. Check destination square
-    Piece const* toPiece = m_board->GetPieceByCoords(toCoords);
-    int const    toOwner = m_board->GetSquareInfoByCoords(toCoords).m_playerControllerId;
-
-    if (toPiece != nullptr)
+    if (m_position.IsOccupied(toSquare))
     {
         if (isTeleport)
         {
             return eMoveResult::VALID_MOVE_PROMOTION;
         }
-        if (toOwner == g_theGame->GetCurrentPlayerControllerId()) return eMoveResult::INVALID_MOVE_DESTINATION_BLOCKED;
+        if (m_position.IsOccupiedBy(toSquare, g_theGame->GetCurrentPlayerControllerId())) return eMoveResult::INVALID_MOVE_DESTINATION_BLOCKED;
     }
     else
     {
@@ -768,16 +905,21 @@ eMoveResult Match::ValidateChessMove(IntVec2 const& fromCoords,
     // 6. Check piece-specific movement rules
     eMoveResult const pieceValidation = ValidatePieceMovement(fromCoords, toCoords, promotionType);
 
-    if (pieceValidation != eMoveResult::VALID_MOVE_NORMAL) return pieceValidation;
+    if (pieceValidation != eMoveResult::VALID_MOVE_NORMAL)
+    {
+        return IsMoveValid(pieceValidation) ? ValidateKingSafety(fromCoords, toCoords, promotionType, pieceValidation) : pieceValidation;
+    }
 
     // 7. Check if sliding pieces are blocked
-    if (!IsPathClear(fromCoords, toCoords, fromPiece->m_definition->m_type))
+    ePieceType const pieceType = m_position.GetPieceType(fromSquare);
+
+    if (!IsPathClear(fromCoords, toCoords, pieceType))
     {
         return eMoveResult::INVALID_MOVE_PATH_BLOCKED;
     }
 
     // 8. Kings apart rule - king cannot move adjacent to enemy king
-    if (fromPiece->m_definition->m_type == ePieceType::KING)
+    if (pieceType == ePieceType::KING)
     {
         if (!IsKingDistanceValid(toCoords))
         {
@@ -785,16 +927,54 @@ eMoveResult Match::ValidateChessMove(IntVec2 const& fromCoords,
         }
     }
 
-    // Determine the type of valid move
-    return DetermineValidMoveType(fromCoords, toCoords, fromPiece);
+    // 9. The move must not leave the mover's own king in check
+    return ValidateKingSafety(fromCoords, toCoords, promotionType, DetermineValidMoveType(fromCoords, toCoords, pieceType));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Rejects a shape-valid move that would leave the mover's king attacked. Most moves are
+/// settled by mask tests against the enemy attack map; only a move out of check, an en passant
+/// capture, or a move by a piece on a line with its own king (a possible pin) is played on a copy.
+/// @return result unchanged if the king is safe, INVALID_MOVE_ENDS_IN_CHECK otherwise.
+eMoveResult Match::ValidateKingSafety(IntVec2 const&    fromCoords,
+                                      IntVec2 const&    toCoords,
+                                      String const&     promotionType,
+                                      eMoveResult const result) const
+{
+    // Castling already checked every square the king crosses
+    if (result == eMoveResult::VALID_CASTLE_KINGSIDE || result == eMoveResult::VALID_CASTLE_QUEENSIDE) return result;
+
+    int const      currentPlayer = g_theGame->GetCurrentPlayerControllerId();
+    int const      fromSquare    = GetSquareFromCoords(fromCoords);
+    int const      kingSquare    = m_position.GetKingSquare(currentPlayer);
+    Bitboard const enemyAttacks  = m_position.GetAttackedSquares(1 - currentPlayer);
+
+    if (kingSquare == INVALID_SQUARE) return result;
+
+    // The enemy map sees through our king, so a king move is safe exactly when its destination is unattacked
+    if (fromSquare == kingSquare)
+    {
+        return (enemyAttacks & GetSquareBit(GetSquareFromCoords(toCoords))) ? eMoveResult::INVALID_MOVE_ENDS_IN_CHECK : result;
+    }
+
+    bool const isInCheck    = (enemyAttacks & GetSquareBit(kingSquare)) != 0;
+    bool const isOnKingLine = (GetQueenAttacks(kingSquare, m_position.GetOccupancy()) & GetSquareBit(fromSquare)) != 0;
+    bool const isEnPassant  = result == eMoveResult::VALID_CAPTURE_ENPASSANT;
+
+    if (!isInCheck && !isOnKingLine && !isEnPassant) return result;
+
+    ChessPosition nextPosition = m_position;
+    sUndoState    undoState;
+    nextPosition.MakeMove(CreateChessMove(fromCoords, toCoords, promotionType, result), undoState);
+
+    return nextPosition.IsInCheck(currentPlayer) ? eMoveResult::INVALID_MOVE_ENDS_IN_CHECK : result;
 }
 
 eMoveResult Match::ValidatePieceMovement(IntVec2 const& fromCoords,
                                          IntVec2 const& toCoords,
                                          String const&  promotionType) const
 {
-    Piece const*     fromPiece = m_board->GetPieceByCoords(fromCoords);
-    ePieceType const pieceType = fromPiece->m_definition->m_type;
+    ePieceType const pieceType = m_position.GetPieceType(GetSquareFromCoords(fromCoords));
 
     int const deltaX    = toCoords.x - fromCoords.x;
     int const deltaY    = toCoords.y - fromCoords.y;
@@ -806,7 +986,7 @@ eMoveResult Match::ValidatePieceMovement(IntVec2 const& fromCoords,
     case ePieceType::PAWN: return ValidatePawnMove(fromCoords, toCoords, promotionType);
     case ePieceType::ROOK: return ValidateRookMove(deltaX, deltaY);
     case ePieceType::BISHOP: return ValidateBishopMove(absDeltaX, absDeltaY);
-    case ePieceType::KNIGHT: return ValidateKnightMove(absDeltaX, absDeltaY);
+    case ePieceType::KNIGHT: return ValidateKnightMove(fromCoords, toCoords);
     case ePieceType::QUEEN: return ValidateQueenMove(deltaX, deltaY, absDeltaX, absDeltaY);
     case ePieceType::KING: return ValidateKingMove(absDeltaX, absDeltaY, fromCoords, toCoords);
     case ePieceType::NONE:
@@ -818,18 +998,13 @@ eMoveResult Match::ValidatePawnMove(IntVec2 const& fromCoords,
                                     IntVec2 const& toCoords,
                                     String const&  promotionType) const
 {
-    Piece const* fromPiece = m_board->GetPieceByCoords(fromCoords);
-    Piece const* toPiece   = m_board->GetPieceByCoords(toCoords);
-
-    int currentPlayer = g_theGame->GetCurrentPlayerControllerId();
-    int direction     = (currentPlayer == 0) ? 1 : -1; // Player 0 moves up, Player 1 moves down
-
-    int deltaX = toCoords.x - fromCoords.x;
-    int deltaY = toCoords.y - fromCoords.y;
+    int const      currentPlayer      = g_theGame->GetCurrentPlayerControllerId();
+    int const      fromSquare         = GetSquareFromCoords(fromCoords);
+    Bitboard const toBit              = GetSquareBit(GetSquareFromCoords(toCoords));
+    bool const     isDestinationEmpty = (m_position.GetOccupancy() & toBit) == 0;
 
     // Check for pawn promotion
-    int promotionRank = (currentPlayer == 0) ? 8 : 1;
-    if (toCoords.y == promotionRank)
+    if (toBit & PROMOTION_RANK_BITBOARDS[currentPlayer])
     {
         if (promotionType.empty())
         {
@@ -842,46 +1017,22 @@ eMoveResult Match::ValidatePawnMove(IntVec2 const& fromCoords,
         }
     }
 
-    // Forward movement (1 or 2 squares)
-    if (deltaX == 0 && toPiece == nullptr)
+    // Forward movement: one square, or two from the starting rank (the path is checked by IsPathClear)
+    if ((GetPawnPushes(fromSquare, currentPlayer) | GetPawnDoublePushes(fromSquare, currentPlayer)) & toBit)
     {
-        if (deltaY == direction) // 1 square forward
-        {
-            return eMoveResult::VALID_MOVE_NORMAL;
-        }
-        else if (deltaY == 2 * direction) // 2 squares forward
-        {
-            // Check if pawn is in starting position or has never moved
-            int startingRank = (currentPlayer == 0) ? 1 : 6;
-            if (fromCoords.y == startingRank || !fromPiece->m_hasMoved)
-            {
-                return eMoveResult::VALID_MOVE_NORMAL;
-            }
-            else
-            {
-                return eMoveResult::INVALID_MOVE_WRONG_MOVE_SHAPE;
-            }
-        }
+        return isDestinationEmpty ? eMoveResult::VALID_MOVE_NORMAL : eMoveResult::INVALID_MOVE_WRONG_MOVE_SHAPE;
     }
+
     // Diagonal capture
-    else if (abs(deltaX) == 1 && deltaY == direction)
+    if (GetPawnAttacks(fromSquare, currentPlayer) & toBit)
     {
-        if (toPiece != nullptr)
+        if (!isDestinationEmpty)
         {
             return eMoveResult::VALID_CAPTURE_NORMAL; // Normal capture
         }
-        else
-        {
-            // Check for en passant
-            if (IsValidEnPassant(fromCoords, toCoords))
-            {
-                return eMoveResult::VALID_CAPTURE_ENPASSANT;
-            }
-            else
-            {
-                return eMoveResult::INVALID_ENPASSANT_STALE;
-            }
-        }
+
+        // Check for en passant
+        return IsValidEnPassant(fromCoords, toCoords) ? eMoveResult::VALID_CAPTURE_ENPASSANT : eMoveResult::INVALID_ENPASSANT_STALE;
     }
 
     return eMoveResult::INVALID_MOVE_WRONG_MOVE_SHAPE;
@@ -907,9 +1058,9 @@ eMoveResult Match::ValidateBishopMove(int absDeltaX, int absDeltaY) const
     return eMoveResult::INVALID_MOVE_WRONG_MOVE_SHAPE;
 }
 
-eMoveResult Match::ValidateKnightMove(int absDeltaX, int absDeltaY) const
+eMoveResult Match::ValidateKnightMove(IntVec2 const& fromCoords, IntVec2 const& toCoords) const
 {
-    if ((absDeltaX == 2 && absDeltaY == 1) || (absDeltaX == 1 && absDeltaY == 2))
+    if (GetKnightAttacks(GetSquareFromCoords(fromCoords)) & GetSquareBit(GetSquareFromCoords(toCoords)))
     {
         return eMoveResult::VALID_MOVE_NORMAL;
     }
@@ -935,19 +1086,14 @@ eMoveResult Match::ValidateKingMove(int            absDeltaX, int absDeltaY,
                                     IntVec2 const& fromCoords,
                                     IntVec2 const& toCoords) const
 {
-    // Check for castling
-    if (absDeltaY == 0 && absDeltaX == 3)
-    {
-        return ValidateCastling(fromCoords, toCoords);
-    }
-
-    if (absDeltaY == 0 && absDeltaX == 4)
+    // Check for castling; the king moves two squares towards the rook
+    if (absDeltaY == 0 && absDeltaX == 2)
     {
         return ValidateCastling(fromCoords, toCoords);
     }
 
     // Normal king move (1 square in any direction)
-    if (absDeltaX <= 1 && absDeltaY <= 1)
+    if (GetKingAttacks(GetSquareFromCoords(fromCoords)) & GetSquareBit(GetSquareFromCoords(toCoords)))
     {
         return eMoveResult::VALID_MOVE_NORMAL;
     }
@@ -958,19 +1104,13 @@ eMoveResult Match::ValidateKingMove(int            absDeltaX, int absDeltaY,
 bool Match::IsKingDistanceValid(IntVec2 const& toCoords) const
 {
     // Find enemy king position
-    int const     enemyPlayerControllerId = 1 - g_theGame->GetCurrentPlayerControllerId();
-    IntVec2 const enemyKingCoords         = m_board->FindKingCoordsByPlayerId(enemyPlayerControllerId);
-
-    // Check if destination is adjacent to enemy king
-    int deltaX = abs(toCoords.x - enemyKingCoords.x);
-    int deltaY = abs(toCoords.y - enemyKingCoords.y);
+    int const enemyPlayerControllerId = 1 - g_theGame->GetCurrentPlayerControllerId();
+    int const enemyKingSquare         = m_position.GetKingSquare(enemyPlayerControllerId);
 
-    if (deltaX <= 1 && deltaY <= 1 && !(deltaX == 0 && deltaY == 0))
-    {
-        return false; // Kings cannot be adjacent
-    }
+    if (enemyKingSquare == INVALID_SQUARE) return true;
 
-    return true;
+    // Kings cannot be adjacent
+    return (GetKingAttacks(enemyKingSquare) & GetSquareBit(GetSquareFromCoords(toCoords))) == 0;
 }
 
 bool Match::IsPathClear(IntVec2 const& fromCoords, IntVec2 const& toCoords, ePieceType const& pieceType) const
@@ -992,66 +1132,42 @@ bool Match::IsPathClear(IntVec2 const& fromCoords, IntVec2 const& toCoords, ePie
         }
     }
 
-    int deltaX = toCoords.x - fromCoords.x;
-    int deltaY = toCoords.y - fromCoords.y;
-
-    int stepX = (deltaX == 0) ? 0 : (deltaX > 0) ? 1 : -1;
-    int stepY = (deltaY == 0) ? 0 : (deltaY > 0) ? 1 : -1;
-
-    IntVec2 currentPos = fromCoords;
-    currentPos.x += stepX;
-    currentPos.y += stepY;
-
-    while (currentPos != toCoords)
-    {
-        if (m_board->GetPieceByCoords(currentPos) != nullptr)
-        {
-            return false;
-        }
-
-        currentPos.x += stepX;
-        currentPos.y += stepY;
-    }
+    // The destination is reachable along the line only if every square before it is empty
+    int const      fromSquare = GetSquareFromCoords(fromCoords);
+    Bitboard const occupancy  = m_position.GetOccupancy();
+    Bitboard const reachable  = fromCoords.x == toCoords.x || fromCoords.y == toCoords.y
+                                    ? GetRookAttacks(fromSquare, occupancy)
+                                    : GetBishopAttacks(fromSquare, occupancy);
 
-    return true;
+    return (reachable & GetSquareBit(GetSquareFromCoords(toCoords))) != 0;
 }
 
 bool Match::IsValidEnPassant(IntVec2 const& fromCoords, IntVec2 const& toCoords) const
 {
-    sPieceMove const lastMove = GetLastPieceMove();
+    // ExecuteMove records the square passed through by the last pawn double-move
+    int const enPassantSquare = m_position.GetEnPassantSquare();
 
-    // Check if last move was a pawn moving 2 squares
-    if (lastMove.piece == nullptr || lastMove.piece->m_definition->m_type != ePieceType::PAWN)
+    if (enPassantSquare == INVALID_SQUARE || GetSquareFromCoords(toCoords) != enPassantSquare)
     {
         return false;
     }
 
-    int lastMoveDelta = abs(lastMove.toCoords.y - lastMove.fromCoords.y);
-    if (lastMoveDelta != 2)
-    {
-        return false;
-    }
+    // The pawn to be captured must stand beside the capturing pawn
+    int const capturedPawnSquare = GetSquareFromCoords(IntVec2(toCoords.x, fromCoords.y));
 
-    // Check if the pawn to be captured is adjacent and the target square is the "passed through" square
-    IntVec2 capturedPawnPos = IntVec2(toCoords.x, fromCoords.y);
-    if (lastMove.toCoords == capturedPawnPos)
-    {
-        IntVec2 passedThroughSquare = IntVec2(lastMove.fromCoords.x, (lastMove.fromCoords.y + lastMove.toCoords.y) / 2);
-        if (toCoords == passedThroughSquare)
-        {
-            return true;
-        }
-    }
-
-    return false;
+    return m_position.GetPieceType(capturedPawnSquare) == ePieceType::PAWN &&
+        m_position.IsOccupiedBy(capturedPawnSquare, 1 - g_theGame->GetCurrentPlayerControllerId());
 }
 
 eMoveResult Match::ValidateCastling(IntVec2 const& fromCoords, IntVec2 const& toCoords) const
 {
-    Piece const* king = m_board->GetPieceByCoords(fromCoords);
+    int const     currentPlayer  = g_theGame->GetCurrentPlayerControllerId();
+    uint8_t const castlingRights = m_position.GetCastlingRights();
+    uint8_t const kingsideRight  = (currentPlayer == 0) ? CASTLE_WHITE_KINGSIDE : CASTLE_BLACK_KINGSIDE;
+    uint8_t const queensideRight = (currentPlayer == 0) ? CASTLE_WHITE_QUEENSIDE : CASTLE_BLACK_QUEENSIDE;
 
     // King must not have moved
-    if (king->m_hasMoved)
+    if ((castlingRights & (kingsideRight | queensideRight)) == 0)
     {
         return eMoveResult::INVALID_CASTLE_KING_HAS_MOVED;
     }
@@ -1060,14 +1176,14 @@ eMoveResult Match::ValidateCastling(IntVec2 const& fromCoords, IntVec2 const& to
     bool    isKingSide = toCoords.x > fromCoords.x;
     IntVec2 rookPos    = IntVec2(isKingSide ? 8 : 1, fromCoords.y);
 
-    Piece const* rook = m_board->GetPieceByCoords(rookPos);
-    if (rook == nullptr || rook->m_definition->m_type != ePieceType::ROOK)
+    int const rookSquare = GetSquareFromCoords(rookPos);
+    if (m_position.GetPieceType(rookSquare) != ePieceType::ROOK || !m_position.IsOccupiedBy(rookSquare, currentPlayer))
     {
         return eMoveResult::INVALID_CASTLE_ROOK_HAS_MOVED;
     }
 
     // Rook must not have moved
-    if (rook->m_hasMoved)
+    if ((castlingRights & (isKingSide ? kingsideRight : queensideRight)) == 0)
     {
         return eMoveResult::INVALID_CASTLE_ROOK_HAS_MOVED;
     }
@@ -1078,16 +1194,30 @@ eMoveResult Match::ValidateCastling(IntVec2 const& fromCoords, IntVec2 const& to
 
     for (int x = startX; x < endX; ++x)
     {
-        if (m_board->GetPieceByCoords(IntVec2(x, fromCoords.y)) != nullptr)
+        if (m_position.IsOccupied(GetSquareFromCoords(IntVec2(x, fromCoords.y))))
         {
             return eMoveResult::INVALID_CASTLE_PATH_BLOCKED;
         }
     }
 
-    // TODO: Add check-related castle validation in future assignments
-    // - King cannot be in check
-    // - King cannot pass through check
-    // - King cannot end in check
+    // King cannot castle out of, through, or into check
+    Bitboard const enemyAttacks = m_position.GetAttackedSquares(1 - currentPlayer);
+    int const      stepX        = isKingSide ? 1 : -1;
+
+    if (enemyAttacks & GetSquareBit(GetSquareFromCoords(fromCoords)))
+    {
+        return eMoveResult::INVALID_CASTLE_OUT_OF_CHECK;
+    }
+
+    if (enemyAttacks & GetSquareBit(GetSquareFromCoords(IntVec2(fromCoords.x + stepX, fromCoords.y))))
+    {
+        return eMoveResult::INVALID_CASTLE_THROUGH_CHECK;
+    }
+
+    if (enemyAttacks & GetSquareBit(GetSquareFromCoords(IntVec2(fromCoords.x + 2 * stepX, fromCoords.y))))
+    {
+        return eMoveResult::INVALID_MOVE_ENDS_IN_CHECK;
+    }
 
     return isKingSide ? eMoveResult::VALID_CASTLE_KINGSIDE : eMoveResult::VALID_CASTLE_QUEENSIDE;
 }
@@ -1101,21 +1231,21 @@ bool Match::IsValidPromotionType(String const& promoteTo) const
         promoteTo == "knight";
 }
 
-eMoveResult Match::DetermineValidMoveType(IntVec2 const& fromCoords,
-                                          IntVec2 const& toCoords,
-                                          Piece const*   fromPiece) const
+eMoveResult Match::DetermineValidMoveType(IntVec2 const&   fromCoords,
+                                          IntVec2 const&   toCoords,
+                                          ePieceType const pieceType) const
 {
-    Piece const* toPiece = m_board->GetPieceByCoords(toCoords);
+    bool const isDestinationEmpty = !m_position.IsOccupied(GetSquareFromCoords(toCoords));
 
     // Check for pawn promotion
-    if (fromPiece->m_definition->m_type == ePieceType::PAWN)
+    if (pieceType == ePieceType::PAWN)
     {
         int currentPlayer = g_theGame->GetCurrentPlayerControllerId();
         int promotionRank = (currentPlayer == 0) ? 8 : 1;
 
         if (toCoords.y == promotionRank)
         {
-            if (toPiece != nullptr)
+            if (!isDestinationEmpty)
             {
                 return eMoveResult::VALID_MOVE_PROMOTION; // Promotion with capture
             }
@@ -1124,14 +1254,14 @@ eMoveResult Match::DetermineValidMoveType(IntVec2 const& fromCoords,
         }
 
         // Check for en passant (already validated in pawn move)
-        if (abs(toCoords.x - fromCoords.x) == 1 && toPiece == nullptr)
+        if (abs(toCoords.x - fromCoords.x) == 1 && isDestinationEmpty)
         {
             return eMoveResult::VALID_CAPTURE_ENPASSANT;
         }
     }
 
     // Check for castling
-    if (fromPiece->m_definition->m_type == ePieceType::KING)
+    if (pieceType == ePieceType::KING)
     {
         int absDeltaX = abs(toCoords.x - fromCoords.x);
         if (absDeltaX == 2)
@@ -1142,7 +1272,7 @@ eMoveResult Match::DetermineValidMoveType(IntVec2 const& fromCoords,
     }
 
     // Check for capture
-    if (toPiece != nullptr)
+    if (!isDestinationEmpty)
     {
         return eMoveResult::VALID_CAPTURE_NORMAL;
     }
@@ -1151,10 +1281,67 @@ eMoveResult Match::DetermineValidMoveType(IntVec2 const& fromCoords,
     return eMoveResult::VALID_MOVE_NORMAL;
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief Rebuilt from the packed move history; the moved piece now stands on the move's to square.
 sPieceMove Match::GetLastPieceMove() const
 {
-    if (m_pieceMoveList.size() == 0) return sPieceMove{};
-    return m_pieceMoveList.back();
+    if (m_moveHistory.empty()) return sPieceMove{};
+
+    PackedMove const lastMove = PackMove(m_moveHistory.back().m_move);
+    return GetPieceMoveFromPackedMove(lastMove, m_board->GetPieceByCoords(GetCoordsFromSquare(GetPackedToSquare(lastMove))));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Every square the piece on fromCoords may move to under the current cheat mode, as a bitboard.
+/// Computed once per selection instead of on every frame and click; ExecuteMove and remote
+/// ChessMove events throw the result away. Normal moves read the move cache; teleports, which the
+/// generator knows nothing about, are validated square by square.
+Bitboard Match::GetSelectionDestinations(IntVec2 const& fromCoords)
+{
+    int const fromSquare = GetSquareFromCoords(fromCoords);
+
+    if (fromSquare == m_selectionFromSquare && m_isCheatMode == m_isSelectionTeleport) return m_selectionDestinations;
+
+    m_selectionFromSquare   = fromSquare;
+    m_isSelectionTeleport   = m_isCheatMode;
+    m_selectionDestinations = 0;
+
+    if (!m_isCheatMode && g_theGame->GetCurrentPlayerControllerId() == m_position.GetSideToMove())
+    {
+        m_selectionDestinations = m_moveCache.GetDestinations(m_position, fromSquare);
+        return m_selectionDestinations;
+    }
+
+    for (int toSquare = 0; toSquare < NUM_SQUARES; ++toSquare)
+    {
+        if (IsMoveValid(ValidateChessMove(fromCoords, GetCoordsFromSquare(toSquare), "", m_isCheatMode))) m_selectionDestinations |= GetSquareBit(toSquare);
+    }
+
+    return m_selectionDestinations;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @return The legal move from the cache, or nullptr for teleports, off-board coords, a turn that is
+/// out of step with the position's side to move, or a move the generator did not produce.
+sChessMove const* Match::FindLegalMove(IntVec2 const& fromCoords,
+                                       IntVec2 const& toCoords,
+                                       String const&  promoteTo,
+                                       bool const     isTeleport)
+{
+    if (isTeleport) return nullptr;
+    if (!m_board->IsCoordValid(fromCoords) || !m_board->IsCoordValid(toCoords)) return nullptr;
+    if (g_theGame->GetCurrentPlayerControllerId() != m_position.GetSideToMove()) return nullptr;
+
+    ePieceType const promotionType = IsValidPromotionType(promoteTo) ? PieceDefinition::GetDefByName(promoteTo)->m_type : ePieceType::QUEEN;
+
+    return m_moveCache.FindMove(m_position, GetSquareFromCoords(fromCoords), GetSquareFromCoords(toCoords), promotionType);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Match::InvalidateSelectionDestinations()
+{
+    m_selectionFromSquare = INVALID_SQUARE;
 }
 
 bool Match::ExecuteMove(IntVec2 const& fromCoords,
@@ -1162,7 +1349,10 @@ bool Match::ExecuteMove(IntVec2 const& fromCoords,
                         String const&  promoteTo,
                         bool const     isTeleport)
 {
-    eMoveResult const result = ValidateChessMove(fromCoords, toCoords, promoteTo, isTeleport);
+    // Legal moves come straight from the move cache; ValidateChessMove only runs for teleports and to
+    // explain why a move was rejected
+    sChessMove const* legalMove = FindLegalMove(fromCoords, toCoords, promoteTo, isTeleport);
+    eMoveResult const result    = legalMove != nullptr ? GetMoveResultFromChessMove(*legalMove) : ValidateChessMove(fromCoords, toCoords, promoteTo, isTeleport);
 
     if (!IsMoveValid(result))
     {
@@ -1170,9 +1360,19 @@ bool Match::ExecuteMove(IntVec2 const& fromCoords,
         return false;
     }
 
-    Piece* fromPiece = m_board->GetPieceByCoords(fromCoords);
-    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Move Player #%d's %s from %s to %s", g_theGame->GetCurrentPlayerControllerId(), m_board->GetPieceByCoords(fromCoords)->m_definition->m_name.c_str(), m_board->ChessCoordToString(fromCoords).c_str(),
+    Piece*           fromPiece = m_board->GetPieceByCoords(fromCoords);
+    sChessMove const move      = legalMove != nullptr ? *legalMove : CreateChessMove(fromCoords, toCoords, promoteTo, result);
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Move Player #%d's %s from %s to %s", g_theGame->GetCurrentPlayerControllerId(), fromPiece->m_definition->m_name.c_str(), m_board->ChessCoordToString(fromCoords).c_str(),
                                                              m_board->ChessCoordToString(toCoords).c_str()));
+
+    // The rules state is committed in one step; the Execute* helpers below only move the piece actors
+    sUndoState undoState;
+    m_position.MakeMove(move, undoState);
+    m_moveHistory.push_back(sUndoEntry{move, undoState});
+    m_hashHistory.Push(m_position.GetHash());
+    m_moveCache.Refresh(m_position);
+    InvalidateSelectionDestinations();
+
     switch (result)
     {
     case eMoveResult::VALID_CAPTURE_ENPASSANT: ExecuteEnPassantCapture(fromCoords, toCoords);
@@ -1189,47 +1389,81 @@ bool Match::ExecuteMove(IntVec2 const& fromCoords,
     default:
         fromPiece->UpdatePositionByCoords(toCoords, 2.f);
         fromPiece->m_hasMoved = true;
-        m_board->UpdateSquareInfoList(fromCoords, toCoords);
+        m_board->MoveSquareByCoords(fromCoords, toCoords);
+        MovePieceOnBoard(fromCoords, toCoords);
 
         break;
     }
 
-    // Record move for en passant detection
-    m_pieceMoveList.push_back({fromPiece, fromCoords, toCoords});
-
     g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, GetMoveResultString(result));
+    CheckForDrawByRule();
     return true;
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief Ends the match in a draw once the current position has occurred three times, or 50 moves
+/// (100 plies) have passed without a capture or pawn move.
+void Match::CheckForDrawByRule()
+{
+    int const   halfmoveClock = m_position.GetHalfmoveClock();
+    char const* drawReason    = nullptr;
+
+    if (m_hashHistory.IsThreefoldRepetition(halfmoveClock)) drawReason = "threefold repetition";
+    else if (halfmoveClock >= 100) drawReason = "the 50-move rule";
+
+    if (drawReason == nullptr) return;
+
+    g_theDevConsole->AddLine(DevConsole::WARNING, "##################################################");
+    g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("[SYSTEM] The match is drawn by %s!", drawReason));
+    g_theDevConsole->AddLine(DevConsole::WARNING, "##################################################");
+    m_gameState = eChessGameState::GAME_OVER;
+    g_theGame->ChangeGameState(eGameState::FINISHED);
+}
+
 void Match::ExecuteEnPassantCapture(IntVec2 const& fromCoords, IntVec2 const& toCoords)
 {
     // Remove the captured pawn
     IntVec2 capturedPawnPos = IntVec2(toCoords.x, fromCoords.y);
     Piece*  fromPiece       = m_board->GetPieceByCoords(fromCoords);
-    fromPiece->UpdatePositionByCoords(toCoords);
-    m_board->UpdateSquareInfoList(fromCoords, toCoords);
-    m_board->UpdateSquareInfoList(capturedPawnPos);
     RemovePieceFromPieceList(capturedPawnPos);
+    m_board->ClearSquareByCoords(capturedPawnPos);
+
     // Move the capturing pawn
-    // m_board->MovePiece(fromCoords, toCoords);
+    fromPiece->UpdatePositionByCoords(toCoords);
+    m_board->MoveSquareByCoords(fromCoords, toCoords);
+    MovePieceOnBoard(fromCoords, toCoords);
 }
 
 void Match::ExecutePawnPromotion(IntVec2 const& fromCoords,
                                  IntVec2 const& toCoords,
                                  String const&  promoteTo)
 {
-    // Handle capture if there's a piece at destination
+    Piece* fromPiece = m_board->GetPieceByCoords(fromCoords);
 
-    Piece* fromPiece        = m_board->GetPieceByCoords(fromCoords);
-    fromPiece->m_definition = PieceDefinition::GetDefByName(promoteTo);
-    // fromPiece->UpdatePositionByCoords(toCoords);
-    ExecuteCapture(fromCoords, toCoords);
+    // VALID_MOVE_PROMOTION also covers teleports onto an occupied square, which only promote pawns
+    bool const   isPromotion   = fromPiece->m_definition->m_type == ePieceType::PAWN && (toCoords.y == 8 || toCoords.y == 1);
+    String const promotionType = IsValidPromotionType(promoteTo) ? promoteTo : "queen";
 
-    // m_board->UpdateSquareInfoList(fromCoords, toCoords, promoteTo);
+    // Handle capture if there's a piece at destination
+    if (m_board->GetPieceByCoords(toCoords) != nullptr)
+    {
+        ExecuteCapture(fromCoords, toCoords, isPromotion ? promotionType : "");
+    }
+    else
+    {
+        fromPiece->UpdatePositionByCoords(toCoords);
+        isPromotion ? m_board->MoveSquareByCoords(fromCoords, toCoords, PieceDefinition::GetDefByName(promotionType)->m_type) : m_board->MoveSquareByCoords(fromCoords, toCoords);
+        MovePieceOnBoard(fromCoords, toCoords);
+    }
+
+    if (isPromotion)
+    {
+        fromPiece->m_definition = PieceDefinition::GetDefByName(promotionType);
+    }
 }
 
 void Match::ExecuteCastling(IntVec2 const& fromCoords,
-                            IntVec2 const& toCoords) const
+                            IntVec2 const& toCoords)
 {
     bool const    isKingSide     = toCoords.x > fromCoords.x;
     IntVec2 const kingToCoords   = IntVec2(isKingSide ? 7 : 3, fromCoords.y);
@@ -1238,15 +1472,17 @@ void Match::ExecuteCastling(IntVec2 const& fromCoords,
 
     Piece* king = m_board->GetPieceByCoords(fromCoords);
     king->UpdatePositionByCoords(kingToCoords);
-    m_board->UpdateSquareInfoList(fromCoords, kingToCoords);
+    m_board->MoveSquareByCoords(fromCoords, kingToCoords);
+    MovePieceOnBoard(fromCoords, kingToCoords);
 
     // Move rook
     Piece* rook = m_board->GetPieceByCoords(rookFromCoords);
     rook->UpdatePositionByCoords(rookToCoords);
-    m_board->UpdateSquareInfoList(rookFromCoords, rookToCoords);
+    m_board->MoveSquareByCoords(rookFromCoords, rookToCoords);
+    MovePieceOnBoard(rookFromCoords, rookToCoords);
 }
 
-void Match::ExecuteKingsideCastling(IntVec2 const& fromCoords) const
+void Match::ExecuteKingsideCastling(IntVec2 const& fromCoords)
 {
     IntVec2 const kingToCoords   = IntVec2(7, fromCoords.y);
     IntVec2 const rookFromCoords = IntVec2(8, fromCoords.y);
@@ -1254,15 +1490,17 @@ void Match::ExecuteKingsideCastling(IntVec2 const& fromCoords) const
 
     Piece* king = m_board->GetPieceByCoords(fromCoords);
     king->UpdatePositionByCoords(kingToCoords);
-    m_board->UpdateSquareInfoList(fromCoords, kingToCoords);
+    m_board->MoveSquareByCoords(fromCoords, kingToCoords);
+    MovePieceOnBoard(fromCoords, kingToCoords);
 
     // Move rook
     Piece* rook = m_board->GetPieceByCoords(rookFromCoords);
     rook->UpdatePositionByCoords(rookToCoords);
-    m_board->UpdateSquareInfoList(rookFromCoords, rookToCoords);
+    m_board->MoveSquareByCoords(rookFromCoords, rookToCoords);
+    MovePieceOnBoard(rookFromCoords, rookToCoords);
 }
 
-void Match::ExecuteQueensideCastling(IntVec2 const& fromCoords) const
+void Match::ExecuteQueensideCastling(IntVec2 const& fromCoords)
 {
     IntVec2 const kingToCoords   = IntVec2(3, fromCoords.y);
     IntVec2 const rookFromCoords = IntVec2(1, fromCoords.y);
@@ -1270,12 +1508,14 @@ void Match::ExecuteQueensideCastling(IntVec2 const& fromCoords) const
 
     Piece* king = m_board->GetPieceByCoords(fromCoords);
     king->UpdatePositionByCoords(kingToCoords);
-    m_board->UpdateSquareInfoList(fromCoords, kingToCoords);
+    m_board->MoveSquareByCoords(fromCoords, kingToCoords);
+    MovePieceOnBoard(fromCoords, kingToCoords);
 
     // Move rook
     Piece* rook = m_board->GetPieceByCoords(rookFromCoords);
     rook->UpdatePositionByCoords(rookToCoords);
-    m_board->UpdateSquareInfoList(rookFromCoords, rookToCoords);
+    m_board->MoveSquareByCoords(rookFromCoords, rookToCoords);
+    MovePieceOnBoard(rookFromCoords, rookToCoords);
 }
 
 void Match::RenderPlayerBasis() const
@@ -1619,11 +1859,12 @@ bool Match::OnChessValidate(EventArgs& args)
                               match->GetGameState() == eChessGameState::PLAYER2_MOVING ? "Player2Moving" :
                               "GameOver";
 
-        std::string boardStr = match->GetBoardStateString();
-
-        match->SendChessCommand(Stringf("ChessValidate state=%s player1=%s player2=%s move=%d board=%s",
+        // key= is the Zobrist key of the full position and fen= spells it out for the mismatch report;
+        // board= is kept for peers that send neither. The board image is not null-terminated.
+        match->SendChessCommand(Stringf("ChessValidate state=%s player1=%s player2=%s move=%d board=%.*s key=%016llx fen=%s",
             stateStr.c_str(), match->m_player1Name.c_str(), match->m_player2Name.c_str(),
-            match->m_moveNumber, boardStr.c_str()));
+            match->m_moveNumber, NUM_SQUARES, match->GetBoardStateString(), static_cast<unsigned long long>(match->m_position.GetHash()),
+            EncodeFENArgument(match->GetFEN()).c_str()));
     }
     else
     {
@@ -1633,8 +1874,10 @@ bool Match::OnChessValidate(EventArgs& args)
         std::string player2 = args.GetValue("player2", "");
         int move = args.GetValue("move", -1);
         std::string board = args.GetValue("board", "");
+        std::string key = args.GetValue("key", "");
+        std::string fen = DecodeFENArgument(args.GetValue("fen", ""));
 
-        if (!match->ValidateGameState(state, player1, player2, move, board))
+        if (!match->ValidateGameState(state, player1, player2, move, board, key, fen))
         {
             match->DisconnectWithReason("VALIDATION FAILED");
             return false;
@@ -1655,6 +1898,7 @@ bool Match::OnChessMove(EventArgs& args)
     String const promotion = args.GetValue("promoteTo", "DEFAULT");
     bool const isTeleport = args.GetValue("teleport", false);
     bool isRemote = args.GetValue("remote", false);
+    bool const isAI = args.GetValue("ai", false);
 
     if (from == "DEFAULT" || to == "DEFAULT")
     {
@@ -1665,8 +1909,12 @@ bool Match::OnChessMove(EventArgs& args)
     IntVec2 const fromCoords = match->m_board->StringToChessCoord(from);
     IntVec2 const toCoords = match->m_board->StringToChessCoord(to);
 
-    // Validate the move
-    eMoveResult result = match->ValidateChessMove(fromCoords, toCoords, promotion, isTeleport);
+    // The opponent's move changes what the local selection may do, even if it is rejected below
+    if (isRemote) match->InvalidateSelectionDestinations();
+
+    // Validate the move against the move cache first; ValidateChessMove explains rejections
+    sChessMove const* legalMove = match->FindLegalMove(fromCoords, toCoords, promotion, isTeleport);
+    eMoveResult result = legalMove != nullptr ? GetMoveResultFromChessMove(*legalMove) : match->ValidateChessMove(fromCoords, toCoords, promotion, isTeleport);
     if (!IsMoveValid(result))
     {
         g_theDevConsole->AddLine(DevConsole::ERROR,
@@ -1674,14 +1922,22 @@ bool Match::OnChessMove(EventArgs& args)
         return false;
     }
 
-    // Check if it's the right player's turn
-    bool shouldBeMyTurn = match->IsMyTurn();
+    // Check if it's the right player's turn; a local game has no "my" side, both seats move here
+    bool shouldBeMyTurn = !match->m_isConnected || match->IsMyTurn();
     if (!isRemote && !shouldBeMyTurn && !isTeleport)
     {
         g_theDevConsole->AddLine(DevConsole::WARNING, "Not your turn!");
         return false;
     }
 
+    // A seat played by the AI only takes moves from its AIController
+    int const sideToMove = match->m_position.GetSideToMove();
+    if (!isRemote && !isAI && !isTeleport && g_theGame->IsAIPlayer(sideToMove))
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("Player #%d is played by the AI", sideToMove));
+        return false;
+    }
+
     // If this is a local move, send it to opponent
     if (!isRemote)
     {
@@ -1700,12 +1956,16 @@ bool Match::OnChessMove(EventArgs& args)
     // Execute the move
     match->OnChessMove(fromCoords, toCoords, promotion, isTeleport);
 
-    // Update move counter and game state
+    // Update move counter and game state; a move that drew the game leaves it over
     if (!isTeleport)
     {
         match->m_moveNumber++;
-        match->m_gameState = (match->m_gameState == eChessGameState::PLAYER1_MOVING) ?
-                            eChessGameState::PLAYER2_MOVING : eChessGameState::PLAYER1_MOVING;
+
+        if (match->m_gameState != eChessGameState::GAME_OVER)
+        {
+            match->m_gameState = (match->m_gameState == eChessGameState::PLAYER1_MOVING) ?
+                                eChessGameState::PLAYER2_MOVING : eChessGameState::PLAYER1_MOVING;
+        }
     }
 
     return true;
@@ -1881,49 +2141,10 @@ void Match::SendChessCommand(const std::string& command)
     g_theNetworkSubsystem->SendRawData(command);
 }
 
-//----------------------------------------------------------------------------------------------------
-std::string Match::GetBoardStateString() const
-{
-    // Convert board to 64-character string representation
-    // This needs to be implemented based on your board representation
-    // Standard notation: RNBKQBNR for back rank, PPPPPPPP for pawns, etc.
-    std::string boardStr = "";
-
-    // Assuming your board has a method to get piece at coordinates
-    for (int row = 8; row >= 1; --row)  // Chess rows 8 to 1
-    {
-        for (int col = 1; col <= 8; ++col)  // Chess columns a-h (1-8)
-        {
-            IntVec2 coords(col, row);
-            Piece const* piece = m_board->GetPieceByCoords(coords);
-
-            if (piece == nullptr)
-            {
-                boardStr += '.';
-            }
-            else
-            {
-                // Convert piece type to standard notation
-                switch (piece->m_definition->m_type)
-                {
-                case ePieceType::PAWN:   boardStr += (piece->m_id == 0 ? 'P' : 'p'); break;
-                case ePieceType::ROOK:   boardStr += (piece->m_id == 0 ? 'R' : 'r'); break;
-                case ePieceType::KNIGHT: boardStr += (piece->m_id == 0 ? 'N' : 'n'); break;
-                case ePieceType::BISHOP: boardStr += (piece->m_id == 0 ? 'B' : 'b'); break;
-                case ePieceType::QUEEN:  boardStr += (piece->m_id == 0 ? 'Q' : 'q'); break;
-                case ePieceType::KING:   boardStr += (piece->m_id == 0 ? 'K' : 'k'); break;
-                default: boardStr += '.'; break;
-                }
-            }
-        }
-    }
-
-    return boardStr;
-}
-
 //----------------------------------------------------------------------------------------------------
 bool Match::ValidateGameState(const std::string& state, const std::string& player1,
-                             const std::string& player2, int move, const std::string& board)
+                             const std::string& player2, int move, const std::string& board,
+                             const std::string& positionKey, const std::string& fen)
 {
     bool isValid = true;
     std::string report = "=== CHESS VALIDATION REPORT ===\n";
@@ -1957,14 +2178,46 @@ bool Match::ValidateGameState(const std::string& state, const std::string& playe
         isValid = false;
     }
 
-    // Validate board state
-    std::string myBoard = GetBoardStateString();
-    if (board != myBoard)
+    // Validate position; a matching Zobrist key settles it without diffing the board image
+    uint64_t const myPositionKey = m_position.GetHash();
+    bool const     isKeyMatching = !positionKey.empty() && strtoull(positionKey.c_str(), nullptr, 16) == myPositionKey;
+
+    if (!positionKey.empty() && !isKeyMatching)
     {
-        report += Stringf("BOARD STATE MISMATCH:\nExpected: %s\nReceived: %s\n", myBoard.c_str(), board.c_str());
+        report += Stringf("POSITION KEY MISMATCH: Expected %016llx, got %s\n", static_cast<unsigned long long>(myPositionKey), positionKey.c_str());
         isValid = false;
     }
 
+    if (!isKeyMatching && !fen.empty())
+    {
+        // FEN also covers side to move, castling and en passant rights, which the board string misses
+        std::string myFen = GetFEN();
+        if (fen != myFen)
+        {
+            report += Stringf("FEN MISMATCH:\nExpected: %s\nReceived: %s\n", myFen.c_str(), fen.c_str());
+            isValid = false;
+        }
+    }
+    else if (!isKeyMatching)
+    {
+        char const* myBoard = GetBoardStateString();
+
+        if (board.size() != NUM_SQUARES || memcmp(board.data(), myBoard, NUM_SQUARES) != 0)
+        {
+            report += Stringf("BOARD STATE MISMATCH:\nExpected: %.*s\nReceived: %s\n", NUM_SQUARES, myBoard, board.c_str());
+
+            // Name the squares that differ; the image runs from a8 to h1
+            for (int imageIndex = 0; imageIndex < NUM_SQUARES && imageIndex < static_cast<int>(board.size()); ++imageIndex)
+            {
+                if (board[imageIndex] == myBoard[imageIndex]) continue;
+
+                report += Stringf("  %c%c: expected %c, got %c\n", 'a' + imageIndex % 8, '8' - imageIndex / 8, myBoard[imageIndex], board[imageIndex]);
+            }
+
+            isValid = false;
+        }
+    }
+
     if (!isValid)
     {
         g_theDevConsole->AddLine(DevConsole::ERROR, report);
@@ -2002,3 +2255,160 @@ bool Match::IsMyTurn() const
     if (m_gameState == eChessGameState::PLAYER2_MOVING && !m_amIPlayer1) return true;
     return false;
 }
+
+//----------------------------------------------------------------------------------------------------
+// PERFT AND RULE VERIFICATION
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+/// @brief ChessPerft [depth=N] [divide=true] [threads=N] [speedup=true] [hash=MB] [position=NAME | fen=FEN | suite=true] [verify=true]
+/// Counts leaf nodes of the legal move tree from the current match position, a named reference position,
+/// or a FEN (with '_' in place of spaces). suite=true runs every reference position against its known count.
+/// threads=0 uses every hardware thread; speedup=true also times a single-threaded run for comparison.
+/// hash=MB shares a perft cache of that size between all threads.
+/// verify=true compares ValidateChessMove with the move generator on the current match position.
+bool Match::OnChessPerft(EventArgs& args)
+{
+    Match* match = g_theGame->m_match;
+    if (!match) return false;
+
+    int const    depth        = args.GetValue("depth", 0);
+    bool const   isDivide     = args.GetValue("divide", false);
+    bool const   isSuite      = args.GetValue("suite", false);
+    bool const   isVerify     = args.GetValue("verify", false);
+    bool const   isSpeedup    = args.GetValue("speedup", false);
+    int const    threadCount  = args.GetValue("threads", 1);
+    int const    hashSizeMB   = args.GetValue("hash", 0);
+    String const positionName = args.GetValue("position", "");
+    String       fen          = args.GetValue("fen", "");
+
+    if (isVerify)
+    {
+        int const mismatchCount = match->VerifyRulesAgainstMoveGenerator();
+        g_theDevConsole->AddLine(mismatchCount == 0 ? DevConsole::INFO_MAJOR : DevConsole::WARNING, Stringf("ChessPerft verify: %d mismatch(es) between ValidateChessMove and the move generator", mismatchCount));
+        return true;
+    }
+
+    ChessThreadPool  threadPool(threadCount);
+    ChessPerftTable* perftTable = hashSizeMB > 0 ? new ChessPerftTable(static_cast<size_t>(hashSizeMB)) : nullptr;
+
+    if (isSuite)
+    {
+        int failedCount = 0;
+
+        for (sChessTestPosition const& testPosition : CHESS_TEST_POSITIONS)
+        {
+            ChessPosition position;
+            position.LoadFromFEN(testPosition.m_fen);
+
+            int const          suiteDepth        = depth > 0 ? depth : testPosition.m_suiteDepth;
+            sPerftResult const result            = RunPerft(position, suiteDepth, false, &threadPool, perftTable);
+            uint64_t const     expectedNodeCount = testPosition.GetExpectedNodeCount(suiteDepth);
+            bool const         isPassed          = expectedNodeCount == 0 || expectedNodeCount == result.m_nodeCount;
+
+            if (!isPassed) ++failedCount;
+
+            g_theDevConsole->AddLine(isPassed ? DevConsole::INFO_MINOR : DevConsole::ERROR, Stringf("%-10s depth %d: %llu nodes (expected %llu), %.3fs, %.0f nps",
+                                                                                             testPosition.m_name, suiteDepth, result.m_nodeCount, expectedNodeCount, result.m_seconds, result.GetNodesPerSecond()));
+        }
+
+        g_theDevConsole->AddLine(failedCount == 0 ? DevConsole::INFO_MAJOR : DevConsole::ERROR, Stringf("ChessPerft suite: %d/%d positions passed", NUM_CHESS_TEST_POSITIONS - failedCount, NUM_CHESS_TEST_POSITIONS));
+        GAME_SAFE_RELEASE(perftTable);
+        return failedCount == 0;
+    }
+
+    ChessPosition             position     = match->m_position;
+    sChessTestPosition const* testPosition = nullptr;
+
+    if (!positionName.empty())
+    {
+        testPosition = FindChessTestPosition(positionName);
+
+        if (testPosition == nullptr)
+        {
+            g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("ChessPerft: unknown position \"%s\"", positionName.c_str()));
+            GAME_SAFE_RELEASE(perftTable);
+            return false;
+        }
+
+        fen = testPosition->m_fen;
+    }
+
+    if (!fen.empty())
+    {
+        fen = DecodeFENArgument(fen);
+
+        if (!position.LoadFromFEN(fen))
+        {
+            g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("ChessPerft: invalid FEN \"%s\"", fen.c_str()));
+            GAME_SAFE_RELEASE(perftTable);
+            return false;
+        }
+    }
+
+    int const          perftDepth = depth > 0 ? depth : 3;
+    sPerftResult const result     = RunPerft(position, perftDepth, isDivide, &threadPool, perftTable);
+
+    for (sPerftDivideEntry const& entry : result.m_divideList)
+    {
+        g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("%s: %llu", GetMoveNotation(entry.m_move).c_str(), entry.m_nodeCount));
+    }
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("ChessPerft depth %d: %llu nodes, %.3fs, %.0f nps, %d thread(s)", perftDepth, result.m_nodeCount, result.m_seconds, result.GetNodesPerSecond(), threadPool.GetThreadCount()));
+
+    if (isSpeedup && threadPool.GetThreadCount() > 1)
+    {
+        if (perftTable != nullptr) perftTable->Clear();
+
+        sPerftResult const singleThreadResult = RunPerft(position, perftDepth, false, nullptr, perftTable);
+
+        g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("ChessPerft speedup: 1 thread %.3fs, %d threads %.3fs, %.2fx", singleThreadResult.m_seconds, threadPool.GetThreadCount(), result.m_seconds,
+                                                                 result.m_seconds > 0.0 ? singleThreadResult.m_seconds / result.m_seconds : 0.0));
+    }
+
+    GAME_SAFE_RELEASE(perftTable);
+
+    if (testPosition != nullptr && testPosition->GetExpectedNodeCount(perftDepth) != 0 && testPosition->GetExpectedNodeCount(perftDepth) != result.m_nodeCount)
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("ChessPerft: expected %llu nodes for %s", testPosition->GetExpectedNodeCount(perftDepth), testPosition->m_name));
+        return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Runs ValidateChessMove on every (from, to) pair of the current position and compares the verdict
+/// with GenerateLegalMoves. Each disagreement is printed to the dev console.
+/// @return Number of (from, to) pairs on which the two disagree.
+int Match::VerifyRulesAgainstMoveGenerator()
+{
+    MoveList const& legalMoves = m_moveCache.GetLegalMoves(m_position);
+
+    bool isGeneratedMove[NUM_SQUARES][NUM_SQUARES] = {};
+
+    for (sChessMove const& move : legalMoves)
+    {
+        isGeneratedMove[move.m_fromSquare][move.m_toSquare] = true;
+    }
+
+    int mismatchCount = 0;
+
+    for (int fromSquare = 0; fromSquare < NUM_SQUARES; ++fromSquare)
+    {
+        for (int toSquare = 0; toSquare < NUM_SQUARES; ++toSquare)
+        {
+            eMoveResult const result      = ValidateChessMove(GetCoordsFromSquare(fromSquare), GetCoordsFromSquare(toSquare), "queen", false);
+            bool const        isValidated = IsMoveValid(result);
+
+            if (isValidated == isGeneratedMove[fromSquare][toSquare]) continue;
+
+            ++mismatchCount;
+            g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("%s%s: ValidateChessMove says \"%s\", move generator says %s",
+                                                                  GetSquareName(fromSquare).c_str(), GetSquareName(toSquare).c_str(), GetMoveResultString(result),
+                                                                  isGeneratedMove[fromSquare][toSquare] ? "legal" : "illegal"));
+        }
+    }
+
+    return mismatchCount;
+}
@@ -6,6 +6,9 @@
 #pragma once
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/EventSystem.hpp"
+#include "Game/Chess/ChessHashHistory.hpp"
+#include "Game/Chess/ChessMoveCache.hpp"
+#include "Game/Chess/ChessPosition.hpp"
 #include "Game/Definition/PieceDefinition.hpp"
 #include "Game/Framework/MatchCommon.hpp"
 #include "Game/Gameplay/Board.hpp"
@@ -17,7 +20,7 @@ class PlayerController;
 
 //----------------------------------------------------------------------------------------------------
 typedef std::vector<Piece*>     PieceList;
-typedef std::vector<sPieceMove> PieceMoveList;
+typedef std::vector<sUndoEntry> MoveHistory;
 
 //----------------------------------------------------------------------------------------------------
 /// @brief
@@ -32,12 +35,20 @@ public:
     void Render() const;
     void RenderGhostPiece() const;
 
-    Board*    m_board = nullptr;
-    PieceList m_pieceList;
+    Board*           m_board = nullptr;
+    PieceList        m_pieceList;
+    ChessPosition    m_position;      // Rules-side state; m_pieceList is only used for rendering
+    MoveHistory      m_moveHistory;   // Every move made on m_position, with what is needed to take it back; grows with the game
+    ChessHashHistory m_hashHistory;   // Zobrist key of every position reached, for repetition detection
+    ChessMoveCache   m_moveCache;     // Legal moves of m_position, regenerated once per committed move
+
+    bool        LoadFromFEN(std::string const& fen);
+    std::string GetFEN() const;
+    bool        CanPlayerMove(int playerId);
 
     void SendChessCommand(const std::string& command);
 
-    bool ValidateGameState(const std::string& state, const std::string& player1, const std::string& player2, int move, const std::string& board);
+    bool ValidateGameState(const std::string& state, const std::string& player1, const std::string& player2, int move, const std::string& board, const std::string& positionKey = "", const std::string& fen = "");
     void DisconnectWithReason(const std::string& reason);
 
 private:
@@ -49,39 +60,49 @@ private:
     static bool OnEnterMatchTurn(EventArgs& args);
     static bool OnExitMatchTurn(EventArgs& args);
     static bool OnMatchInitialized(EventArgs& args);
+    static bool OnChessPerft(EventArgs& args);
+    static bool OnChessLoadFEN(EventArgs& args);
 
     void OnChessMove(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promoteTo, bool isTeleport);
     bool ExecuteMove(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promoteTo, bool isTeleport);
 
     void        ExecuteEnPassantCapture(IntVec2 const& fromCoords, IntVec2 const& toCoords);
     void        ExecutePawnPromotion(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promoteTo);
-    void        ExecuteCastling(IntVec2 const& fromCoords, IntVec2 const& toCoords) const;
-    void        ExecuteKingsideCastling(IntVec2 const& fromCoords) const;
-    void        ExecuteQueensideCastling(IntVec2 const& fromCoords) const;
+    void        ExecuteCastling(IntVec2 const& fromCoords, IntVec2 const& toCoords);
+    void        ExecuteKingsideCastling(IntVec2 const& fromCoords);
+    void        ExecuteQueensideCastling(IntVec2 const& fromCoords);
     void        RenderPlayerBasis() const;
     static bool OnGameDataReceived(EventArgs& args);
 
     void ExecuteCapture(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promoteTo = "");
 
     void RemovePieceFromPieceList(IntVec2 const& toCoords);
+    void MovePieceOnBoard(IntVec2 const& fromCoords, IntVec2 const& toCoords);
+    void       CheckForDrawByRule();
+    sChessMove CreateChessMove(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promoteTo, eMoveResult result) const;
 
     eMoveResult ValidateChessMove(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promotionType, bool isTeleport) const;
     eMoveResult ValidatePieceMovement(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promotionType) const;
     eMoveResult ValidatePawnMove(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promotionType) const;
     eMoveResult ValidateRookMove(int deltaX, int deltaY) const;
     eMoveResult ValidateBishopMove(int absDeltaX, int absDeltaY) const;
-    eMoveResult ValidateKnightMove(int absDeltaX, int absDeltaY) const;
+    eMoveResult ValidateKnightMove(IntVec2 const& fromCoords, IntVec2 const& toCoords) const;
     eMoveResult ValidateQueenMove(int deltaX, int deltaY, int absDeltaX, int absDeltaY) const;
     eMoveResult ValidateKingMove(int absDeltaX, int absDeltaY, IntVec2 const& fromCoords, IntVec2 const& toCoords) const;
     eMoveResult ValidateCastling(IntVec2 const& fromCoords, IntVec2 const& toCoords) const;
-    eMoveResult DetermineValidMoveType(IntVec2 const& fromCoords, IntVec2 const& toCoords, Piece const* fromPiece) const;
+    eMoveResult ValidateKingSafety(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promotionType, eMoveResult result) const;
+    eMoveResult DetermineValidMoveType(IntVec2 const& fromCoords, IntVec2 const& toCoords, ePieceType pieceType) const;
 
     bool IsKingDistanceValid(IntVec2 const& toCoords) const;
     bool IsPathClear(IntVec2 const& fromCoords, IntVec2 const& toCoords, ePieceType const& pieceType) const;
     bool IsValidEnPassant(IntVec2 const& fromCoords, IntVec2 const& toCoords) const;
     bool IsValidPromotionType(String const& promoteTo) const;
 
-    sPieceMove GetLastPieceMove() const;
+    sPieceMove        GetLastPieceMove() const;
+    Bitboard          GetSelectionDestinations(IntVec2 const& fromCoords);
+    sChessMove const* FindLegalMove(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promoteTo, bool isTeleport);
+    void              InvalidateSelectionDestinations();
+    int               VerifyRulesAgainstMoveGenerator();
 
     void        RegisterNetworkCommands();
     void        UnregisterNetworkCommands();
@@ -106,7 +127,7 @@ private:
     eChessGameState GetGameState() const { return m_gameState; }
     int             GetMoveNumber() const { return m_moveNumber; }
     bool            IsConnected() const { return m_isConnected; }
-    std::string     GetBoardStateString() const;
+    char const*     GetBoardStateString() const { return m_board->GetBoardImage(); }
     bool            IsMyTurn() const;
 
     Camera* m_screenCamera = nullptr;
@@ -117,13 +138,17 @@ private:
     float m_sunIntensity     = 0.85f;
     float m_ambientIntensity = 0.35f;
 
-    PieceMoveList m_pieceMoveList;
     Piece*        m_selectedPiece      = nullptr;
     bool          m_showGhostPiece     = false;
     Vec3          m_ghostPiecePosition = Vec3::ZERO;
     Piece*        m_ghostSourcePiece   = nullptr;
     bool          m_isCheatMode        = false;
 
+    // Legal destinations of the selected piece, cached until the selection, cheat mode or position changes
+    Bitboard m_selectionDestinations = 0;
+    int      m_selectionFromSquare   = INVALID_SQUARE;
+    bool     m_isSelectionTeleport   = false;
+
     // 網路狀態
     std::string     m_myPlayerName          = "Player";
     std::string     m_player1Name           = "";    // 執白棋的玩家
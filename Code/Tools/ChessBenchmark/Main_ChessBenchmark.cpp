@@ -0,0 +1,237 @@
+//----------------------------------------------------------------------------------------------------
+// Main_ChessBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#include "Game/Chess/ChessAttacks.hpp"
+#include "Game/Chess/ChessPosition.hpp"
+#include "Game/Chess/ChessSliderAttacks.hpp"
+#include "Game/Chess/ChessTestPositions.hpp"
+#include "Game/Chess/MoveGenerator.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    typedef void (*LegalMoveGenerator)(ChessPosition const& position, MoveList& moves);
+
+    int constexpr SLIDER_OCCUPANCY_COUNT = 4096;
+    int constexpr SLIDER_LOOKUP_COUNT    = 1 << 24;
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Bulk-counting perft with a pluggable legal move generator, so generators can be compared
+    /// on identical trees.
+    uint64_t PerftWithGenerator(ChessPosition&           position,
+                                int const                depth,
+                                LegalMoveGenerator const generator)
+    {
+        MoveList moves;
+        generator(position, moves);
+
+        if (depth == 1) return static_cast<uint64_t>(moves.GetSize());
+
+        uint64_t   nodeCount = 0;
+        sUndoState undoState;
+
+        for (sChessMove const& move : moves)
+        {
+            position.MakeMove(move, undoState);
+            nodeCount += PerftWithGenerator(position, depth - 1, generator);
+            position.UnmakeMove(move, undoState);
+        }
+
+        return nodeCount;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    double TimePerft(ChessPosition const&     position,
+                     int const                depth,
+                     LegalMoveGenerator const generator,
+                     uint64_t&                nodeCount)
+    {
+        ChessPosition scratchPosition = position;
+        auto const    startTime       = std::chrono::steady_clock::now();
+
+        nodeCount = PerftWithGenerator(scratchPosition, depth, generator);
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Looks up bishop and rook attacks from every square over the occupancies with the current
+    /// slider backend. The checksum mixes every result so backends can be checked against each other.
+    double TimeSliderLookups(Bitboard const* occupancies,
+                             Bitboard&       checksum)
+    {
+        auto const startTime = std::chrono::steady_clock::now();
+
+        checksum = 0;
+
+        for (int lookupIndex = 0; lookupIndex < SLIDER_LOOKUP_COUNT; ++lookupIndex)
+        {
+            int const      square    = lookupIndex & 63;
+            Bitboard const occupancy = occupancies[(lookupIndex >> 6) & (SLIDER_OCCUPANCY_COUNT - 1)];
+
+            checksum ^= GetBishopAttacks(square, occupancy) + GetRookAttacks(square, occupancy) * lookupIndex;
+        }
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Usage: ChessBenchmark [iterations] [perftDepth] ["FEN"]
+// Calls GenerateLegalMoves repeatedly on each standard test position, or only on the given FEN, and
+// reports moves per second, then runs a bulk-counting perft on each position with the pin/check-mask
+// generator and with the make/test/unmake baseline and reports the speedup. Finally times bishop and
+// rook attack lookups with every slider backend the CPU supports.
+int main(int const argc, char* argv[])
+{
+    int const iterations = argc > 1 ? atoi(argv[1]) : 200000;
+    int const perftDepth = argc > 2 ? atoi(argv[2]) : 4;
+
+    if (iterations <= 0 || perftDepth <= 0)
+    {
+        printf("Usage: ChessBenchmark [iterations] [perftDepth] [\"FEN\"]\n");
+        return 1;
+    }
+
+    sChessTestPosition        fenPosition;
+    sChessTestPosition const* testPositions     = CHESS_TEST_POSITIONS;
+    int                       testPositionCount = NUM_CHESS_TEST_POSITIONS;
+
+    if (argc > 3)
+    {
+        fenPosition.m_name = "FEN";
+        fenPosition.m_fen  = argv[3];
+        testPositions      = &fenPosition;
+        testPositionCount  = 1;
+    }
+
+    eSliderBackend const selectedBackend = GetSliderBackend();
+
+    printf("Slider backend: %s\n\n", GetSliderBackendName(selectedBackend));
+    printf("%-12s %8s %12s %12s %16s\n", "Position", "Moves", "Iterations", "Seconds", "Moves/Second");
+
+    MoveList moves;
+
+    uint64_t totalMoves   = 0;
+    double   totalSeconds = 0.0;
+
+    for (int positionIndex = 0; positionIndex < testPositionCount; ++positionIndex)
+    {
+        sChessTestPosition const& testPosition = testPositions[positionIndex];
+        ChessPosition             position;
+
+        if (!position.LoadFromFEN(testPosition.m_fen))
+        {
+            printf("%-12s invalid FEN \"%s\"\n", testPosition.m_name, testPosition.m_fen);
+            return 1;
+        }
+
+        uint64_t   generatedMoves = 0;
+        auto const startTime      = std::chrono::steady_clock::now();
+
+        for (int iteration = 0; iteration < iterations; ++iteration)
+        {
+            moves.Clear();
+            GenerateLegalMoves(position, moves);
+            generatedMoves += moves.GetSize();
+        }
+
+        double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+        printf("%-12s %8d %12d %12.3f %16.0f\n", testPosition.m_name, moves.GetSize(), iterations, seconds, static_cast<double>(generatedMoves) / seconds);
+
+        totalMoves += generatedMoves;
+        totalSeconds += seconds;
+    }
+
+    printf("%-12s %8s %12s %12.3f %16.0f\n", "Total", "", "", totalSeconds, static_cast<double>(totalMoves) / totalSeconds);
+
+    printf("\nPerft depth %d, bulk counting at the last ply\n", perftDepth);
+    printf("%-12s %12s %16s %16s %8s\n", "Position", "Nodes", "MakeTest NPS", "Masked NPS", "Speedup");
+
+    double totalBaselineSeconds = 0.0;
+    double totalMaskedSeconds   = 0.0;
+    bool   isMatching           = true;
+
+    for (int positionIndex = 0; positionIndex < testPositionCount; ++positionIndex)
+    {
+        sChessTestPosition const& testPosition = testPositions[positionIndex];
+        ChessPosition             position;
+        position.LoadFromFEN(testPosition.m_fen);
+
+        uint64_t     baselineNodes   = 0;
+        uint64_t     maskedNodes     = 0;
+        double const baselineSeconds = TimePerft(position, perftDepth, GenerateLegalMovesByMakeTest, baselineNodes);
+        double const maskedSeconds   = TimePerft(position, perftDepth, GenerateLegalMoves, maskedNodes);
+
+        printf("%-12s %12llu %16.0f %16.0f %7.2fx%s\n", testPosition.m_name, static_cast<unsigned long long>(maskedNodes),
+               static_cast<double>(baselineNodes) / baselineSeconds, static_cast<double>(maskedNodes) / maskedSeconds, baselineSeconds / maskedSeconds,
+               baselineNodes == maskedNodes ? "" : "  NODE COUNT MISMATCH");
+
+        isMatching = isMatching && baselineNodes == maskedNodes;
+        totalBaselineSeconds += baselineSeconds;
+        totalMaskedSeconds += maskedSeconds;
+    }
+
+    printf("%-12s %12s %16s %16s %7.2fx\n", "Total", "", "", "", totalBaselineSeconds / totalMaskedSeconds);
+
+    printf("\nSlider attacks, %d bishop and rook lookups over %d random occupancies\n", SLIDER_LOOKUP_COUNT, SLIDER_OCCUPANCY_COUNT);
+    printf("%-12s %12s %16s %8s\n", "Backend", "Seconds", "Lookups/Second", "Speedup");
+
+    Bitboard occupancies[SLIDER_OCCUPANCY_COUNT];
+    uint64_t randomState = 0x2545F4914F6CDD1DULL;
+
+    for (Bitboard& occupancy : occupancies)
+    {
+        // Xorshift; ANDing two draws gives roughly the quarter-full boards of a middlegame
+        Bitboard draws[2];
+        for (Bitboard& draw : draws)
+        {
+            randomState ^= randomState << 13;
+            randomState ^= randomState >> 7;
+            randomState ^= randomState << 17;
+            draw = randomState;
+        }
+        occupancy = draws[0] & draws[1];
+    }
+
+    double   loopSeconds  = 0.0;
+    Bitboard loopChecksum = 0;
+
+    for (int backendIndex = 0; backendIndex < NUM_SLIDER_BACKENDS; ++backendIndex)
+    {
+        eSliderBackend const backend = static_cast<eSliderBackend>(backendIndex);
+
+        if (!SetSliderBackend(backend))
+        {
+            printf("%-12s %12s\n", GetSliderBackendName(backend), "unsupported");
+            continue;
+        }
+
+        // Warm the tables and caches before timing
+        Bitboard     checksum = 0;
+        TimeSliderLookups(occupancies, checksum);
+        double const seconds = TimeSliderLookups(occupancies, checksum);
+
+        if (backend == eSliderBackend::LOOP)
+        {
+            loopSeconds  = seconds;
+            loopChecksum = checksum;
+        }
+
+        printf("%-12s %12.3f %16.0f %7.2fx%s\n", GetSliderBackendName(backend), seconds, SLIDER_LOOKUP_COUNT / seconds, loopSeconds / seconds,
+               checksum == loopChecksum ? "" : "  RESULT MISMATCH");
+
+        isMatching = isMatching && checksum == loopChecksum;
+    }
+
+    SetSliderBackend(selectedBackend);
+
+    return isMatching ? 0 : 1;
+}
@@ -0,0 +1,573 @@
+//----------------------------------------------------------------------------------------------------
+// Main_ChessMicroBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Game/Chess/ChessAttacks.hpp"
+#include "Game/Chess/ChessMoveCache.hpp"
+#include "Game/Chess/ChessPosition.hpp"
+#include "Game/Chess/ChessTestPositions.hpp"
+#include "Game/Chess/MoveGenerator.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    /// @brief One (position, from, to) question as Match asks it when a move is validated. Half of the
+    /// queries are legal moves and half are squares the piece cannot reach.
+    struct sMoveQuery
+    {
+        int m_positionIndex = 0;
+        int m_fromSquare    = INVALID_SQUARE;
+        int m_toSquare      = INVALID_SQUARE;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    struct sBenchmarkFixture
+    {
+        ChessPosition            m_positions[NUM_CHESS_TEST_POSITIONS];
+        ChessMoveCache           m_moveCaches[NUM_CHESS_TEST_POSITIONS];
+        std::vector<sMoveQuery>  m_moveQueries;
+        std::vector<std::string> m_moveNotations[NUM_CHESS_TEST_POSITIONS];
+        std::vector<sMoveQuery>  m_sliderQueries;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Runs operationCount operations and returns a checksum of their results, so the optimizer
+    /// cannot drop the work.
+    typedef uint64_t (*BenchmarkFunction)(sBenchmarkFixture& fixture, int operationCount);
+
+    struct sBenchmark
+    {
+        char const*       m_name        = nullptr;
+        char const*       m_description = nullptr;
+        BenchmarkFunction m_function    = nullptr;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    struct sBenchmarkResult
+    {
+        char const* m_name                = nullptr;
+        int         m_operationsPerSample = 0;
+        int         m_sampleCount         = 0;
+        double      m_minNs               = 0.0;    // Nanoseconds per operation
+        double      m_medianNs            = 0.0;
+        double      m_meanNs              = 0.0;
+        double      m_stdDevNs            = 0.0;
+        double      m_maxNs               = 0.0;
+        double      m_baselineMedianNs    = 0.0;    // 0 when the baseline has no entry for this benchmark
+        double      m_changePercent       = 0.0;
+        bool        m_isRegression        = false;
+    };
+
+    uint64_t volatile g_checksumSink = 0;
+
+    double constexpr MIN_SAMPLE_SECONDS = 0.002;
+
+    //------------------------------------------------------------------------------------------------
+    // Benchmarks. Each mirrors a Match hot path on the engine-free core it now delegates to.
+    //------------------------------------------------------------------------------------------------
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Match::FindLegalMove, the fast path of every move validation.
+    uint64_t BenchmarkFindLegalMove(sBenchmarkFixture& fixture,
+                                    int const          operationCount)
+    {
+        uint64_t  checksum   = 0;
+        int const queryCount = static_cast<int>(fixture.m_moveQueries.size());
+
+        for (int operation = 0; operation < operationCount; ++operation)
+        {
+            sMoveQuery const& query = fixture.m_moveQueries[operation % queryCount];
+            sChessMove const* move  = fixture.m_moveCaches[query.m_positionIndex].FindMove(fixture.m_positions[query.m_positionIndex], query.m_fromSquare, query.m_toSquare);
+
+            checksum += move != nullptr ? static_cast<uint64_t>(move->m_toSquare) : 1;
+        }
+
+        return checksum;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief ChessMoveCache::Refresh after every committed move.
+    uint64_t BenchmarkGenerateLegalMoves(sBenchmarkFixture& fixture,
+                                         int const          operationCount)
+    {
+        uint64_t checksum = 0;
+        MoveList moves;
+
+        for (int operation = 0; operation < operationCount; ++operation)
+        {
+            moves.Clear();
+            GenerateLegalMoves(fixture.m_positions[operation % NUM_CHESS_TEST_POSITIONS], moves);
+            checksum += static_cast<uint64_t>(moves.GetSize());
+        }
+
+        return checksum;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Board::GetPieceByCoords and the rules' piece queries: one operation reads every square.
+    uint64_t BenchmarkPieceLookup(sBenchmarkFixture& fixture,
+                                  int const          operationCount)
+    {
+        uint64_t checksum = 0;
+
+        for (int operation = 0; operation < operationCount; ++operation)
+        {
+            ChessPosition const& position = fixture.m_positions[operation % NUM_CHESS_TEST_POSITIONS];
+
+            for (int square = 0; square < NUM_SQUARES; ++square)
+            {
+                checksum += static_cast<uint64_t>(position.GetPieceType(square)) + static_cast<uint64_t>(position.GetPlayerId(square));
+            }
+        }
+
+        return checksum;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Match::GetBoardStateString as it was before Board kept the image: 64 characters from the
+    /// mailbox.
+    uint64_t BenchmarkBoardStateString(sBenchmarkFixture& fixture,
+                                       int const          operationCount)
+    {
+        uint64_t checksum = 0;
+        char     boardImage[NUM_SQUARES];
+
+        for (int operation = 0; operation < operationCount; ++operation)
+        {
+            ChessPosition const& position = fixture.m_positions[operation % NUM_CHESS_TEST_POSITIONS];
+
+            for (int imageIndex = 0; imageIndex < NUM_SQUARES; ++imageIndex)
+            {
+                int const  square   = GetSquare(imageIndex & 7, 7 - (imageIndex >> 3));
+                char const notation = GetPieceNotation(position.GetPieceType(square), position.GetPlayerId(square));
+
+                boardImage[imageIndex] = notation != '\0' ? notation : '.';
+            }
+
+            checksum += static_cast<uint64_t>(boardImage[operation & 63]);
+        }
+
+        return checksum;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Match::GetFEN, sent with every ChessValidate.
+    uint64_t BenchmarkToFEN(sBenchmarkFixture& fixture,
+                            int const          operationCount)
+    {
+        uint64_t checksum = 0;
+
+        for (int operation = 0; operation < operationCount; ++operation)
+        {
+            checksum += fixture.m_positions[operation % NUM_CHESS_TEST_POSITIONS].ToFEN().size();
+        }
+
+        return checksum;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Match::IsPathClear for a queen-like move: is the destination in the slider attack set.
+    uint64_t BenchmarkIsPathClear(sBenchmarkFixture& fixture,
+                                  int const          operationCount)
+    {
+        uint64_t  checksum   = 0;
+        int const queryCount = static_cast<int>(fixture.m_sliderQueries.size());
+
+        for (int operation = 0; operation < operationCount; ++operation)
+        {
+            sMoveQuery const& query     = fixture.m_sliderQueries[operation % queryCount];
+            Bitboard const    occupancy = fixture.m_positions[query.m_positionIndex].GetOccupancy();
+
+            checksum += (GetQueenAttacks(query.m_fromSquare, occupancy) & GetSquareBit(query.m_toSquare)) != 0 ? 1 : 0;
+        }
+
+        return checksum;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief The ChessMove text path: turn "e2e4" style text into a legal move of the position.
+    uint64_t BenchmarkParseMoveNotation(sBenchmarkFixture& fixture,
+                                        int const          operationCount)
+    {
+        uint64_t checksum = 0;
+
+        for (int operation = 0; operation < operationCount; ++operation)
+        {
+            int const                       positionIndex = operation % NUM_CHESS_TEST_POSITIONS;
+            std::vector<std::string> const& notations     = fixture.m_moveNotations[positionIndex];
+            ChessPosition const&            position      = fixture.m_positions[positionIndex];
+            MoveList const&                 legalMoves    = fixture.m_moveCaches[positionIndex].GetLegalMoves(position);
+            sChessMove const*               move          = FindMoveByNotation(legalMoves, notations[(operation / NUM_CHESS_TEST_POSITIONS) % notations.size()]);
+
+            checksum += move != nullptr ? static_cast<uint64_t>(move->m_fromSquare) : 1;
+        }
+
+        return checksum;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief ChessPosition::MakeMove and UnmakeMove, the position side of Match::ExecuteMove.
+    uint64_t BenchmarkMakeUnmakeMove(sBenchmarkFixture& fixture,
+                                     int const          operationCount)
+    {
+        uint64_t   checksum = 0;
+        sUndoState undoState;
+
+        for (int operation = 0; operation < operationCount; ++operation)
+        {
+            int const         positionIndex = operation % NUM_CHESS_TEST_POSITIONS;
+            ChessPosition&    position      = fixture.m_positions[positionIndex];
+            MoveList const&   legalMoves    = fixture.m_moveCaches[positionIndex].GetLegalMoves(position);
+            sChessMove const& move          = legalMoves[(operation / NUM_CHESS_TEST_POSITIONS) % legalMoves.GetSize()];
+
+            position.MakeMove(move, undoState);
+            checksum += position.GetHash();
+            position.UnmakeMove(move, undoState);
+        }
+
+        return checksum;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    sBenchmark constexpr BENCHMARKS[] =
+    {
+        {"FindLegalMove", "Match::FindLegalMove / ValidateChessMove fast path", BenchmarkFindLegalMove},
+        {"GenerateLegalMoves", "ChessMoveCache::Refresh per committed move", BenchmarkGenerateLegalMoves},
+        {"PieceLookup", "Board::GetPieceByCoords over all 64 squares", BenchmarkPieceLookup},
+        {"BoardStateString", "Match::GetBoardStateString built from the mailbox", BenchmarkBoardStateString},
+        {"ToFEN", "Match::GetFEN", BenchmarkToFEN},
+        {"IsPathClear", "Match::IsPathClear slider test", BenchmarkIsPathClear},
+        {"ParseMoveNotation", "ChessMove text to legal move", BenchmarkParseMoveNotation},
+        {"MakeUnmakeMove", "Match::ExecuteMove position update", BenchmarkMakeUnmakeMove},
+    };
+
+    //------------------------------------------------------------------------------------------------
+    void BuildFixture(sBenchmarkFixture& fixture)
+    {
+        for (int positionIndex = 0; positionIndex < NUM_CHESS_TEST_POSITIONS; ++positionIndex)
+        {
+            ChessPosition& position = fixture.m_positions[positionIndex];
+            position.LoadFromFEN(CHESS_TEST_POSITIONS[positionIndex].m_fen);
+
+            MoveList const& legalMoves = fixture.m_moveCaches[positionIndex].GetLegalMoves(position);
+
+            for (sChessMove const& move : legalMoves)
+            {
+                // Every legal move, then the same piece asked about the mirrored square, which is rarely legal
+                fixture.m_moveQueries.push_back({positionIndex, move.m_fromSquare, move.m_toSquare});
+                fixture.m_moveQueries.push_back({positionIndex, move.m_fromSquare, move.m_toSquare ^ 56});
+                fixture.m_moveNotations[positionIndex].push_back(GetMoveNotation(move));
+            }
+
+            for (int fromSquare = 0; fromSquare < NUM_SQUARES; ++fromSquare)
+            {
+                fixture.m_sliderQueries.push_back({positionIndex, fromSquare, (fromSquare * 29 + 17) & 63});
+            }
+        }
+    }
+
+    //------------------------------------------------------------------------------------------------
+    double TimeSample(sBenchmark const&  benchmark,
+                      sBenchmarkFixture& fixture,
+                      int const          operationCount)
+    {
+        auto const startTime = std::chrono::steady_clock::now();
+
+        g_checksumSink = g_checksumSink + benchmark.m_function(fixture, operationCount);
+
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Doubles the batch until one sample takes MIN_SAMPLE_SECONDS, runs the warm-up samples, then
+    /// times sampleCount samples and summarizes their per-operation cost.
+    sBenchmarkResult RunBenchmark(sBenchmark const&  benchmark,
+                                  sBenchmarkFixture& fixture,
+                                  int const          warmupCount,
+                                  int const          sampleCount)
+    {
+        int operationCount = 64;
+
+        while (operationCount < (1 << 28) && TimeSample(benchmark, fixture, operationCount) < MIN_SAMPLE_SECONDS)
+        {
+            operationCount *= 2;
+        }
+
+        for (int warmupIndex = 0; warmupIndex < warmupCount; ++warmupIndex)
+        {
+            TimeSample(benchmark, fixture, operationCount);
+        }
+
+        std::vector<double> sampleNs;
+
+        for (int sampleIndex = 0; sampleIndex < sampleCount; ++sampleIndex)
+        {
+            sampleNs.push_back(TimeSample(benchmark, fixture, operationCount) * 1e9 / operationCount);
+        }
+
+        std::sort(sampleNs.begin(), sampleNs.end());
+
+        sBenchmarkResult result;
+        result.m_name                = benchmark.m_name;
+        result.m_operationsPerSample = operationCount;
+        result.m_sampleCount         = sampleCount;
+        result.m_minNs               = sampleNs.front();
+        result.m_maxNs               = sampleNs.back();
+        result.m_medianNs            = sampleCount % 2 == 1 ? sampleNs[sampleCount / 2] : 0.5 * (sampleNs[sampleCount / 2 - 1] + sampleNs[sampleCount / 2]);
+
+        for (double const ns : sampleNs) result.m_meanNs += ns;
+        result.m_meanNs /= sampleCount;
+
+        for (double const ns : sampleNs) result.m_stdDevNs += (ns - result.m_meanNs) * (ns - result.m_meanNs);
+        result.m_stdDevNs = sampleCount > 1 ? sqrt(result.m_stdDevNs / (sampleCount - 1)) : 0.0;
+
+        return result;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Reads the median of a benchmark from a file this tool wrote. Only the "name" and
+    /// "median_ns" keys are looked at, so the rest of the file may change between versions.
+    /// @return 0 if the file has no entry for the benchmark.
+    double FindBaselineMedian(std::string const& baselineJson,
+                              char const*        name)
+    {
+        std::string const nameKey = std::string("\"name\": \"") + name + "\"";
+        size_t const      nameAt  = baselineJson.find(nameKey);
+
+        if (nameAt == std::string::npos) return 0.0;
+
+        size_t const entryEnd = baselineJson.find('}', nameAt);
+        size_t const medianAt = baselineJson.find("\"median_ns\":", nameAt);
+
+        if (medianAt == std::string::npos || medianAt > entryEnd) return 0.0;
+
+        return strtod(baselineJson.c_str() + medianAt + strlen("\"median_ns\":"), nullptr);
+    }
+
+    //------------------------------------------------------------------------------------------------
+    bool ReadFile(char const*  path,
+                  std::string& contents)
+    {
+        FILE* file = fopen(path, "rb");
+
+        if (file == nullptr) return false;
+
+        char   buffer[4096];
+        size_t readCount = 0;
+
+        while ((readCount = fread(buffer, 1, sizeof(buffer), file)) > 0)
+        {
+            contents.append(buffer, readCount);
+        }
+
+        fclose(file);
+        return true;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief text as the inside of a JSON string literal, so Windows paths such as C:\tmp survive.
+    std::string EscapeJsonString(char const* text)
+    {
+        std::string escaped;
+
+        for (char const* textChar = text; *textChar != '\0'; ++textChar)
+        {
+            unsigned char const code = static_cast<unsigned char>(*textChar);
+
+            if (code == '\\' || code == '"')
+            {
+                escaped += '\\';
+                escaped += *textChar;
+            }
+            else if (code < 0x20)
+            {
+                char buffer[8];
+                snprintf(buffer, sizeof(buffer), "\\u%04x", code);
+                escaped += buffer;
+            }
+            else
+            {
+                escaped += *textChar;
+            }
+        }
+
+        return escaped;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void WriteJson(FILE*                                file,
+                   std::vector<sBenchmarkResult> const& results,
+                   int const                            warmupCount,
+                   int const                            sampleCount,
+                   char const*                          baselinePath,
+                   double const                         thresholdPercent)
+    {
+        fprintf(file, "{\n");
+        fprintf(file, "  \"tool\": \"ChessMicroBenchmark\",\n");
+        fprintf(file, "  \"warmup_samples\": %d,\n", warmupCount);
+        fprintf(file, "  \"samples\": %d,\n", sampleCount);
+
+        if (baselinePath != nullptr)
+        {
+            fprintf(file, "  \"baseline\": \"%s\",\n", EscapeJsonString(baselinePath).c_str());
+            fprintf(file, "  \"threshold_percent\": %.1f,\n", thresholdPercent);
+        }
+
+        fprintf(file, "  \"benchmarks\": [\n");
+
+        for (size_t resultIndex = 0; resultIndex < results.size(); ++resultIndex)
+        {
+            sBenchmarkResult const& result = results[resultIndex];
+
+            fprintf(file, "    {\"name\": \"%s\", \"operations_per_sample\": %d, \"min_ns\": %.3f, \"median_ns\": %.3f, \"mean_ns\": %.3f, \"stddev_ns\": %.3f, \"max_ns\": %.3f",
+                    result.m_name, result.m_operationsPerSample, result.m_minNs, result.m_medianNs, result.m_meanNs, result.m_stdDevNs, result.m_maxNs);
+
+            if (baselinePath != nullptr && result.m_baselineMedianNs > 0.0)
+            {
+                fprintf(file, ", \"baseline_median_ns\": %.3f, \"change_percent\": %.2f, \"regression\": %s",
+                        result.m_baselineMedianNs, result.m_changePercent, result.m_isRegression ? "true" : "false");
+            }
+
+            fprintf(file, "}%s\n", resultIndex + 1 < results.size() ? "," : "");
+        }
+
+        fprintf(file, "  ]\n");
+        fprintf(file, "}\n");
+    }
+
+    //------------------------------------------------------------------------------------------------
+    void PrintUsage()
+    {
+        fprintf(stderr, "Usage: ChessMicroBenchmark [--samples N] [--warmup N] [--filter TEXT] [--out FILE] [--baseline FILE] [--threshold PERCENT]\n");
+        fprintf(stderr, "  Prints per-operation timings as JSON. --out also writes them to FILE, to be used as a later baseline.\n");
+        fprintf(stderr, "  --baseline compares each median with FILE and exits with 1 if any is more than --threshold\n");
+        fprintf(stderr, "  percent slower (default 10).\n");
+        fprintf(stderr, "  Benchmarks:\n");
+
+        for (sBenchmark const& benchmark : BENCHMARKS)
+        {
+            fprintf(stderr, "    %-20s %s\n", benchmark.m_name, benchmark.m_description);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Micro-benchmarks for the paths Match runs on every frame, click and network message, timed on the
+// engine-free core they delegate to over the standard test positions. The raycast loop in
+// Match::Update and PieceDefinition::CreateMeshByID depend on the Engine and are not covered here.
+int main(int const argc, char* argv[])
+{
+    int         sampleCount      = 25;
+    int         warmupCount      = 3;
+    double      thresholdPercent = 10.0;
+    char const* filter           = nullptr;
+    char const* outPath          = nullptr;
+    char const* baselinePath     = nullptr;
+
+    for (int argIndex = 1; argIndex < argc; ++argIndex)
+    {
+        bool const hasValue = argIndex + 1 < argc;
+
+        if (strcmp(argv[argIndex], "--samples") == 0 && hasValue)
+        {
+            sampleCount = atoi(argv[++argIndex]);
+        }
+        else if (strcmp(argv[argIndex], "--warmup") == 0 && hasValue)
+        {
+            warmupCount = atoi(argv[++argIndex]);
+        }
+        else if (strcmp(argv[argIndex], "--filter") == 0 && hasValue)
+        {
+            filter = argv[++argIndex];
+        }
+        else if (strcmp(argv[argIndex], "--out") == 0 && hasValue)
+        {
+            outPath = argv[++argIndex];
+        }
+        else if (strcmp(argv[argIndex], "--baseline") == 0 && hasValue)
+        {
+            baselinePath = argv[++argIndex];
+        }
+        else if (strcmp(argv[argIndex], "--threshold") == 0 && hasValue)
+        {
+            thresholdPercent = atof(argv[++argIndex]);
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (sampleCount <= 0 || warmupCount < 0 || thresholdPercent < 0.0)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    std::string baselineJson;
+
+    if (baselinePath != nullptr && !ReadFile(baselinePath, baselineJson))
+    {
+        fprintf(stderr, "Cannot read baseline \"%s\"\n", baselinePath);
+        return 1;
+    }
+
+    sBenchmarkFixture fixture;
+    BuildFixture(fixture);
+
+    std::vector<sBenchmarkResult> results;
+    bool                          hasRegression = false;
+
+    for (sBenchmark const& benchmark : BENCHMARKS)
+    {
+        if (filter != nullptr && strstr(benchmark.m_name, filter) == nullptr) continue;
+
+        sBenchmarkResult result = RunBenchmark(benchmark, fixture, warmupCount, sampleCount);
+
+        if (baselinePath != nullptr)
+        {
+            result.m_baselineMedianNs = FindBaselineMedian(baselineJson, benchmark.m_name);
+
+            if (result.m_baselineMedianNs > 0.0)
+            {
+                result.m_changePercent = (result.m_medianNs / result.m_baselineMedianNs - 1.0) * 100.0;
+                result.m_isRegression  = result.m_changePercent > thresholdPercent;
+            }
+        }
+
+        fprintf(stderr, "%-20s median %10.2f ns/op  stddev %8.2f%s\n", result.m_name, result.m_medianNs, result.m_stdDevNs, result.m_isRegression ? "  REGRESSION" : "");
+
+        hasRegression = hasRegression || result.m_isRegression;
+        results.push_back(result);
+    }
+
+    WriteJson(stdout, results, warmupCount, sampleCount, baselinePath, thresholdPercent);
+
+    if (outPath != nullptr)
+    {
+        FILE* outFile = fopen(outPath, "wb");
+
+        if (outFile == nullptr)
+        {
+            fprintf(stderr, "Cannot write \"%s\"\n", outPath);
+            return 1;
+        }
+
+        WriteJson(outFile, results, warmupCount, sampleCount, baselinePath, thresholdPercent);
+        fclose(outFile);
+    }
+
+    return hasRegression ? 1 : 0;
+}
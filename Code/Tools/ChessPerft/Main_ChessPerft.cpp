@@ -0,0 +1,264 @@
+//----------------------------------------------------------------------------------------------------
+// Main_ChessPerft.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+#include "Game/Chess/ChessHashHistory.hpp"
+#include "Game/Chess/ChessPerft.hpp"
+#include "Game/Chess/ChessPerftTable.hpp"
+#include "Game/Chess/ChessPosition.hpp"
+#include "Game/Chess/ChessTestPositions.hpp"
+#include "Game/Chess/ChessThreadPool.hpp"
+#include "Game/Chess/MoveGenerator.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    void PrintUsage()
+    {
+        printf("Usage: ChessPerft [--depth N] [--divide] [--threads N] [--speedup] [--hash MB] [--position NAME | --fen \"FEN\"] [--moves \"MOVES\"]\n");
+        printf("  With no position, runs the reference suite and checks every count against the known value.\n");
+        printf("  --threads 0 uses every hardware thread; --speedup also times a single-threaded run for comparison.\n");
+        printf("  --hash MB shares a perft cache of that size between all threads (default 0, off).\n");
+        printf("  --moves plays moves such as \"e2e4 e7e5\" from the position (default Initial) first, reports how\n");
+        printf("  often the final position has occurred, then runs perft from it.\n");
+        printf("  Positions:");
+
+        for (sChessTestPosition const& testPosition : CHESS_TEST_POSITIONS)
+        {
+            printf(" %s", testPosition.m_name);
+        }
+
+        printf("\n");
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Plays the space-separated moves on position, tracking repetitions as Match does, and
+    /// prints how often the final position has occurred. Returns false at the first illegal move.
+    bool PlayMoves(ChessPosition&     position,
+                   std::string const& movesText)
+    {
+        ChessHashHistory hashHistory;
+        hashHistory.Push(position.GetHash());
+
+        int    playedCount = 0;
+        size_t textIndex   = 0;
+
+        while (textIndex < movesText.size())
+        {
+            size_t const moveEnd = std::min(movesText.find(' ', textIndex), movesText.size());
+
+            if (moveEnd == textIndex)
+            {
+                ++textIndex;
+                continue;
+            }
+
+            std::string const moveText = movesText.substr(textIndex, moveEnd - textIndex);
+            MoveList          legalMoves;
+
+            GenerateLegalMoves(position, legalMoves);
+
+            sChessMove const* move = FindMoveByNotation(legalMoves, moveText);
+
+            if (move == nullptr)
+            {
+                printf("Illegal move \"%s\"\n", moveText.c_str());
+                return false;
+            }
+
+            sUndoState undoState;
+            position.MakeMove(*move, undoState);
+            hashHistory.Push(position.GetHash());
+            ++playedCount;
+            textIndex = moveEnd;
+        }
+
+        int const repetitionCount = hashHistory.CountRepetitions(position.GetHalfmoveClock());
+
+        printf("After %d move(s) the position has occurred %d time(s)%s\n", playedCount, repetitionCount + 1,
+               hashHistory.IsThreefoldRepetition(position.GetHalfmoveClock()) ? ", a threefold repetition" : "");
+        return true;
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief Runs and prints one perft. isPassed is false if the count differs from a known reference count.
+    sPerftResult RunAndPrintPerft(char const*               name,
+                                  ChessPosition const&      position,
+                                  int const                 depth,
+                                  bool const                isDivide,
+                                  ChessThreadPool&          threadPool,
+                                  ChessPerftTable*          perftTable,
+                                  bool const                isSpeedup,
+                                  sChessTestPosition const* testPosition,
+                                  bool&                     isPassed)
+    {
+        sPerftResult const result = RunPerft(position, depth, isDivide, &threadPool, perftTable);
+
+        for (sPerftDivideEntry const& entry : result.m_divideList)
+        {
+            printf("  %-6s %llu\n", GetMoveNotation(entry.m_move).c_str(), static_cast<unsigned long long>(entry.m_nodeCount));
+        }
+
+        uint64_t const expectedNodeCount = testPosition != nullptr ? testPosition->GetExpectedNodeCount(depth) : 0;
+        isPassed = expectedNodeCount == 0 || expectedNodeCount == result.m_nodeCount;
+
+        printf("%-10s depth %d  nodes %12llu  %8.3fs  %12.0f nps  %s\n",
+               name, depth, static_cast<unsigned long long>(result.m_nodeCount), result.m_seconds, result.GetNodesPerSecond(),
+               expectedNodeCount == 0 ? "" : isPassed ? "PASS" : "FAIL");
+
+        if (!isPassed)
+        {
+            printf("           expected %llu\n", static_cast<unsigned long long>(expectedNodeCount));
+        }
+
+        if (isSpeedup && threadPool.GetThreadCount() > 1)
+        {
+            if (perftTable != nullptr) perftTable->Clear();
+
+            sPerftResult const singleThreadResult = RunPerft(position, depth, false, nullptr, perftTable);
+
+            printf("           1 thread %8.3fs, %d threads %8.3fs, speedup %.2fx%s\n", singleThreadResult.m_seconds, threadPool.GetThreadCount(), result.m_seconds,
+                   result.m_seconds > 0.0 ? singleThreadResult.m_seconds / result.m_seconds : 0.0,
+                   singleThreadResult.m_nodeCount == result.m_nodeCount ? "" : "  (node counts differ!)");
+        }
+
+        return result;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int main(int const argc, char* argv[])
+{
+    int                       depth         = 0;
+    int                       threadCount   = 1;
+    int                       hashMegabytes = 0;
+    bool                      isDivide      = false;
+    bool                      isSpeedup     = false;
+    std::string               fen;
+    std::string               movesText;
+    sChessTestPosition const* testPosition  = nullptr;
+
+    for (int argIndex = 1; argIndex < argc; ++argIndex)
+    {
+        bool const hasValue = argIndex + 1 < argc;
+
+        if (strcmp(argv[argIndex], "--depth") == 0 && hasValue)
+        {
+            depth = atoi(argv[++argIndex]);
+        }
+        else if (strcmp(argv[argIndex], "--divide") == 0)
+        {
+            isDivide = true;
+        }
+        else if (strcmp(argv[argIndex], "--threads") == 0 && hasValue)
+        {
+            threadCount = atoi(argv[++argIndex]);
+        }
+        else if (strcmp(argv[argIndex], "--hash") == 0 && hasValue)
+        {
+            hashMegabytes = atoi(argv[++argIndex]);
+        }
+        else if (strcmp(argv[argIndex], "--speedup") == 0)
+        {
+            isSpeedup = true;
+        }
+        else if (strcmp(argv[argIndex], "--fen") == 0 && hasValue)
+        {
+            fen = argv[++argIndex];
+        }
+        else if (strcmp(argv[argIndex], "--moves") == 0 && hasValue)
+        {
+            movesText = argv[++argIndex];
+        }
+        else if (strcmp(argv[argIndex], "--position") == 0 && hasValue)
+        {
+            testPosition = FindChessTestPosition(argv[++argIndex]);
+
+            if (testPosition == nullptr)
+            {
+                printf("Unknown position \"%s\"\n", argv[argIndex]);
+                PrintUsage();
+                return 1;
+            }
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    ChessPosition   position;
+    ChessThreadPool threadPool(threadCount);
+
+    std::unique_ptr<ChessPerftTable> perftTable;
+
+    if (hashMegabytes > 0)
+    {
+        perftTable.reset(new ChessPerftTable(static_cast<size_t>(hashMegabytes)));
+    }
+
+    printf("Using %d thread(s)", threadPool.GetThreadCount());
+
+    if (perftTable) printf(", %zu MB perft table (%zu entries)", perftTable->GetSizeInBytes() / (1024 * 1024), perftTable->GetEntryCount());
+
+    printf("\n");
+
+    // Single position given on the command line
+    if (!fen.empty() || testPosition != nullptr || !movesText.empty())
+    {
+        if (fen.empty() && testPosition == nullptr) testPosition = &CHESS_TEST_POSITIONS[0];
+
+        char const* const positionFen = fen.empty() ? testPosition->m_fen : fen.c_str();
+
+        if (!position.LoadFromFEN(positionFen))
+        {
+            printf("Invalid FEN \"%s\"\n", positionFen);
+            return 1;
+        }
+
+        if (!movesText.empty() && !PlayMoves(position, movesText)) return 1;
+
+        if (depth <= 0) depth = testPosition != nullptr ? testPosition->m_suiteDepth : 4;
+
+        // Reference counts only hold for the test position itself
+        bool isPassed = true;
+        RunAndPrintPerft(fen.empty() ? testPosition->m_name : "FEN", position, depth, isDivide, threadPool, perftTable.get(), isSpeedup,
+                         fen.empty() && movesText.empty() ? testPosition : nullptr, isPassed);
+        return isPassed ? 0 : 1;
+    }
+
+    // Reference suite
+    int      failedCount  = 0;
+    uint64_t totalNodes   = 0;
+    double   totalSeconds = 0.0;
+
+    for (sChessTestPosition const& suitePosition : CHESS_TEST_POSITIONS)
+    {
+        int const suiteDepth = depth > 0 ? depth : suitePosition.m_suiteDepth;
+        bool      isPassed   = true;
+
+        position.LoadFromFEN(suitePosition.m_fen);
+
+        sPerftResult const result = RunAndPrintPerft(suitePosition.m_name, position, suiteDepth, isDivide, threadPool, perftTable.get(), isSpeedup, &suitePosition, isPassed);
+
+        totalNodes += result.m_nodeCount;
+        totalSeconds += result.m_seconds;
+
+        if (!isPassed) ++failedCount;
+    }
+
+    printf("%d/%d positions passed, %llu nodes in %.3fs (%.0f nps)\n", NUM_CHESS_TEST_POSITIONS - failedCount, NUM_CHESS_TEST_POSITIONS,
+           static_cast<unsigned long long>(totalNodes), totalSeconds, totalSeconds > 0.0 ? static_cast<double>(totalNodes) / totalSeconds : 0.0);
+
+    return failedCount == 0 ? 0 : 1;
+}
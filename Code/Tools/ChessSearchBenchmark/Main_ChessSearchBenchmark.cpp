@@ -0,0 +1,208 @@
+//----------------------------------------------------------------------------------------------------
+// Main_ChessSearchBenchmark.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "Game/Chess/ChessParallelSearch.hpp"
+#include "Game/Chess/ChessTestPositions.hpp"
+#include "Game/Chess/ChessThreadPool.hpp"
+#include "Game/Chess/ChessTranspositionTable.hpp"
+
+//----------------------------------------------------------------------------------------------------
+namespace
+{
+    //------------------------------------------------------------------------------------------------
+    struct sScalingResult
+    {
+        int      m_threadCount        = 0;
+        uint64_t m_nodeCount          = 0;
+        double   m_seconds            = 0.0;
+        uint64_t m_probeCount         = 0;
+        uint64_t m_hitCount           = 0;
+        uint64_t m_failHighs          = 0;
+        uint64_t m_firstMoveFailHighs = 0;
+    };
+
+    //------------------------------------------------------------------------------------------------
+    void PrintUsage()
+    {
+        printf("Usage: ChessSearchBenchmark [--depth N] [--threads N] [--hash MB] [--position NAME | --fen \"FEN\"]\n");
+        printf("  Searches every position to a fixed depth with 1, 2, 4, ... up to --threads threads (default 0,\n");
+        printf("  every hardware thread) and reports time to depth, nodes per second and the speedup over one\n");
+        printf("  thread. The table (--hash, default 64 MB) is cleared before every search. \"1st cut\" is the share\n");
+        printf("  of fail-highs caused by the first move searched, a measure of move ordering.\n");
+        printf("  Positions:");
+
+        for (sChessTestPosition const& testPosition : CHESS_TEST_POSITIONS)
+        {
+            printf(" %s", testPosition.m_name);
+        }
+
+        printf("\n");
+    }
+
+    //------------------------------------------------------------------------------------------------
+    /// @brief 1, 2, 4, ... below maxThreadCount, then maxThreadCount itself.
+    std::vector<int> GetThreadCounts(int const maxThreadCount)
+    {
+        std::vector<int> threadCounts;
+
+        for (int threadCount = 1; threadCount < maxThreadCount; threadCount *= 2)
+        {
+            threadCounts.push_back(threadCount);
+        }
+
+        threadCounts.push_back(maxThreadCount);
+        return threadCounts;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int main(int const argc, char* argv[])
+{
+    int                       depth          = 8;
+    int                       maxThreadCount = 0;
+    int                       hashMegabytes  = 64;
+    std::string               fen;
+    sChessTestPosition const* testPosition   = nullptr;
+
+    for (int argIndex = 1; argIndex < argc; ++argIndex)
+    {
+        bool const hasValue = argIndex + 1 < argc;
+
+        if (strcmp(argv[argIndex], "--depth") == 0 && hasValue)
+        {
+            depth = atoi(argv[++argIndex]);
+        }
+        else if (strcmp(argv[argIndex], "--threads") == 0 && hasValue)
+        {
+            maxThreadCount = atoi(argv[++argIndex]);
+        }
+        else if (strcmp(argv[argIndex], "--hash") == 0 && hasValue)
+        {
+            hashMegabytes = atoi(argv[++argIndex]);
+        }
+        else if (strcmp(argv[argIndex], "--fen") == 0 && hasValue)
+        {
+            fen = argv[++argIndex];
+        }
+        else if (strcmp(argv[argIndex], "--position") == 0 && hasValue)
+        {
+            testPosition = FindChessTestPosition(argv[++argIndex]);
+
+            if (testPosition == nullptr)
+            {
+                printf("Unknown position \"%s\"\n", argv[argIndex]);
+                PrintUsage();
+                return 1;
+            }
+        }
+        else
+        {
+            PrintUsage();
+            return 1;
+        }
+    }
+
+    if (depth <= 0 || hashMegabytes <= 0)
+    {
+        PrintUsage();
+        return 1;
+    }
+
+    if (maxThreadCount <= 0) maxThreadCount = ChessThreadPool::GetHardwareThreadCount();
+
+    sChessTestPosition        fenPosition;
+    sChessTestPosition const* positions     = CHESS_TEST_POSITIONS;
+    int                       positionCount = NUM_CHESS_TEST_POSITIONS;
+
+    if (!fen.empty())
+    {
+        fenPosition.m_name = "FEN";
+        fenPosition.m_fen  = fen.c_str();
+        positions          = &fenPosition;
+        positionCount      = 1;
+    }
+    else if (testPosition != nullptr)
+    {
+        positions     = testPosition;
+        positionCount = 1;
+    }
+
+    ChessTranspositionTable transpositionTable(static_cast<size_t>(hashMegabytes));
+
+    printf("Depth %d, %zu MB table%s, up to %d thread(s)\n\n", depth, transpositionTable.GetSizeInBytes() / (1024 * 1024),
+           transpositionTable.IsUsingLargePages() ? " on large pages" : "", maxThreadCount);
+    printf("%-8s %-10s %-6s %7s %12s %9s %12s %8s %8s\n", "Threads", "Position", "Move", "Score", "Nodes", "Seconds", "Nodes/s", "TT hits", "1st cut");
+
+    std::vector<sScalingResult> scalingResults;
+
+    for (int const threadCount : GetThreadCounts(maxThreadCount))
+    {
+        ChessParallelSearch search(threadCount, &transpositionTable);
+        sScalingResult      scalingResult;
+
+        scalingResult.m_threadCount = threadCount;
+
+        for (int positionIndex = 0; positionIndex < positionCount; ++positionIndex)
+        {
+            ChessPosition    position;
+            ChessHashHistory hashHistory;
+
+            if (!position.LoadFromFEN(positions[positionIndex].m_fen))
+            {
+                printf("Invalid FEN \"%s\"\n", positions[positionIndex].m_fen);
+                return 1;
+            }
+
+            hashHistory.Push(position.GetHash());
+            transpositionTable.Clear();
+
+            sSearchLimits limits;
+            limits.m_depth = depth;
+
+            sSearchResult const result = search.Search(position, hashHistory, limits);
+
+            printf("%-8d %-10s %-6s %7d %12llu %9.3f %12.0f %7.1f%% %7.1f%%\n", threadCount, positions[positionIndex].m_name,
+                   result.HasBestMove() ? GetMoveNotation(result.m_bestMove).c_str() : "-", result.m_score,
+                   static_cast<unsigned long long>(result.m_nodeCount), result.m_seconds, result.GetNodesPerSecond(), result.GetTTHitRate() * 100.0,
+                   result.GetFirstMoveFailHighRate() * 100.0);
+
+            scalingResult.m_nodeCount += result.m_nodeCount;
+            scalingResult.m_seconds += result.m_seconds;
+            scalingResult.m_probeCount += result.m_ttProbeCount;
+            scalingResult.m_hitCount += result.m_ttHitCount;
+            scalingResult.m_failHighs += result.m_failHighCount;
+            scalingResult.m_firstMoveFailHighs += result.m_firstMoveFailHighCount;
+        }
+
+        scalingResults.push_back(scalingResult);
+    }
+
+    // Time to depth is the speedup that matters; nodes/s shows how much of it the hardware delivered
+    sScalingResult const& baseline = scalingResults[0];
+
+    printf("\nScaling, time to depth %d over %d position(s)\n", depth, positionCount);
+    printf("%-8s %9s %14s %12s %10s %10s %8s %8s\n", "Threads", "Seconds", "Nodes", "Nodes/s", "TTD gain", "NPS gain", "TT hits", "1st cut");
+
+    for (sScalingResult const& scalingResult : scalingResults)
+    {
+        double const nodesPerSecond         = scalingResult.m_seconds > 0.0 ? static_cast<double>(scalingResult.m_nodeCount) / scalingResult.m_seconds : 0.0;
+        double const baselineNodesPerSecond = baseline.m_seconds > 0.0 ? static_cast<double>(baseline.m_nodeCount) / baseline.m_seconds : 0.0;
+        double const hitRate                = scalingResult.m_probeCount > 0 ? static_cast<double>(scalingResult.m_hitCount) / static_cast<double>(scalingResult.m_probeCount) : 0.0;
+        double const firstMoveFailHighRate  = scalingResult.m_failHighs > 0 ? static_cast<double>(scalingResult.m_firstMoveFailHighs) / static_cast<double>(scalingResult.m_failHighs) : 0.0;
+
+        printf("%-8d %9.3f %14llu %12.0f %9.2fx %9.2fx %7.1f%% %7.1f%%\n", scalingResult.m_threadCount, scalingResult.m_seconds,
+               static_cast<unsigned long long>(scalingResult.m_nodeCount), nodesPerSecond,
+               scalingResult.m_seconds > 0.0 ? baseline.m_seconds / scalingResult.m_seconds : 0.0,
+               baselineNodesPerSecond > 0.0 ? nodesPerSecond / baselineNodesPerSecond : 0.0, hitRate * 100.0, firstMoveFailHighRate * 100.0);
+    }
+
+    return 0;
+}